@@ -0,0 +1,79 @@
+/******************************
+ * File name   : Bench.h
+ * Purpose     : Mithrill project.
+ *               Vector, quaternion and filters math microbenchmarks
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __BENCH_H_
+#define __BENCH_H_
+
+/* Benchmarks are timed by probes clock (see Probe.h), so they are built only
+ * if MTHL_PROBES is defined. Same benchmarks run on device ('B' command) and
+ * on host (mithril_bench), both print CSV lines:
+ *
+ *   name,type,iterations,ticks,per_op,unit
+ *   quater_mul,float,1000,52013,52.01,cycles
+ */
+#ifdef MTHL_PROBES
+
+#include <stdint.h>
+
+/* Mithril namespace */
+namespace mthl
+{
+  /* Math microbenchmarks namespace */
+  namespace bench
+  {
+    static constexpr const uint32_t
+      DEVICE_ITERATIONS = 1000, // iterations of benchmark run by device command
+      REPEATS = 3;              // runs of benchmark, fastest one is reported
+
+    /* Benchmark result structure */
+    struct Result
+    {
+      const char *name;    // operation
+      const char *type;    // number type
+      uint32_t iterations; // number of operations
+      uint32_t ticks;      // ticks of all operations (probes clock)
+    }; // End of 'Result' structure
+
+    /* Number of benchmarks getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Number of benchmarks.
+     */
+    uint32_t getCount();
+
+    /* Run benchmark function.
+     * Loop overhead (index and result store) is included in ticks.
+     *
+     * Arguments:
+     *   uint32_t index -- benchmark number, less than getCount()
+     *   uint32_t iterations -- number of operations per run
+     *
+     * Returns:
+     *   Result of fastest of REPEATS runs.
+     */
+    Result run(uint32_t index, uint32_t iterations);
+
+    /* Ticks unit name getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   "ns" for host clock, "cycles" for DWT counter.
+     */
+    const char * getUnit();
+  } // end of 'bench' namespace
+} // end of 'mthl' namespace
+
+#endif // MTHL_PROBES
+
+#endif // __BENCH_H_
@@ -5,20 +5,29 @@
  *               Controller class declaration.
  * Author      : Filippov Denis
  * Create date : 09.03.2020
- * Last change : 18.05.2020
+ * Last change : 18.10.2026
  ******************************/
 
 #ifndef __CONTROLLER_H_
 #define __CONTROLLER_H_
 
-#include <vector>
-#include <queue>
 #include <functional>
-#include <memory>
 
-#include "Sensors/IMU.h"
+#include "Sensors/SensorSet.h"
+#include "Sensors/Sampler.h"
+#include "Utils/RingBuffer.h"
+#include "Storage/CalibrationStore.h"
+#include "Storage/PostureLog.h"
+#include "UART_RX.h"
 #include "Request/Request.h"
+#include "Request/CommandParser.h"
+#include "Scheduler/Scheduler.h"
 #include "Functionality/Functionality.h"
+#include "Functionality/Sensors/SensorsUpdate.h"
+#include "Functionality/Telemetry/TelemetryStream.h"
+#include "Functionality/Telemetry/LogDownload.h"
+#include "Functionality/Storage/LogMaintenance.h"
+#include "Functionality/Health/Posture/Posture.h"
 
 /* Mithril namespace */
 namespace mthl
@@ -72,7 +81,130 @@ namespace mthl
      */
     void isPostureOnSet(bool value);
 
+    /* Check if any telemetry message is subscribed function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   true if telemetry is on.
+     */
+    bool isTelemetryOnGet();
+
+    /* Subscribe to all telemetry messages or unsubscribe from them function.
+     *
+     * Arguments:
+     *   value -- is telemetry on.
+     *
+     * Returns:
+     *   None.
+     */
+    void isTelemetryOnSet(bool value);
+
+    /* Check if telemetry message is subscribed function.
+     *
+     * Arguments:
+     *   telemetry::Message type -- message type.
+     *
+     * Returns:
+     *   true if message is sent.
+     */
+    bool isTelemetrySubscribed(telemetry::Message type);
+
+    /* Telemetry subscription setter.
+     *
+     * Arguments:
+     *   uint8_t mask -- bit (1 << (type - 1)) for each sent message type.
+     *
+     * Returns:
+     *   None.
+     */
+    void setTelemetryMask(uint8_t mask);
+
+    /* Set bounds of correct spine angle function.
+     *
+     * Arguments:
+     *   uint32_t angle -- angle number
+     *   float minValue, maxValue -- bounds of correct angle (degrees)
+     *
+     * Returns:
+     *   true if bounds were set.
+     */
+    bool setPostureBounds(uint32_t angle, float minValue, float maxValue);
+
+    /* Set complementary filter time constant of all sensors function.
+     *
+     * Arguments:
+     *   float timeConst -- time constant (seconds)
+     *
+     * Returns:
+     *   None.
+     */
+    void setFilterTimeConst(float timeConst);
+
+    /* Set sampling period of all sensors function.
+     *
+     * Arguments:
+     *   uint32_t period -- sampling period (milliseconds)
+     *
+     * Returns:
+     *   true if period was set for all sensors.
+     */
+    bool setSamplePeriod(uint32_t period);
+
+    /* Stop reading of IMU-sensors function.
+     * Waits for current sample set, so buses are free when function returns.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void pauseSampling();
+
+    /* Resume reading of IMU-sensors function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void resumeSampling();
+
+    /* Number of dropped command frames getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Number of broken command frames.
+     */
+    uint32_t getCommandErrorsCount();
+
+    /* Posture history log getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Reference on posture log.
+     */
+    PostureLog & getPostureLog();
+
+    /* Start sending posture log to application function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void downloadLog();
+
     /* Calibrate all sensors function.
+     * Calibration is saved to flash and restored after reset.
      *
      * Arguments:
      *   None.
@@ -83,21 +215,48 @@ namespace mthl
      void calibrate();
 
   private:
-    std::vector<std::unique_ptr<IMU>> IMUSensors;  // list of IMU-sensors
-    std::queue<Request> reqQueue;   // queue of requests
+    std::array<MCU6050, SENSORS_COUNT> IMUSensors; // IMU-sensors along spine
+    Sampler sampler;                // DMA sampling engine for IMU-sensors
+    RingBuffer<Request, 16> reqQueue; // queue of requests from interrupts
+    CommandParser cmdParser;        // parser of bytes from application
+    Scheduler scheduler;            // scheduler of Mithril functions
+    SensorsUpdate sensorsUpdate;    // filtering of new IMU-sensors data
+    TelemetryStream telemetryStream; // streaming of IMU-sensors data to application
+    PostureProcASF posture;         // posture processing
+    CalibrationStore calibrationStore; // sensors calibration saved in flash
+    PostureLog postureLog;          // posture history saved in flash
+    LogDownload logDownload;        // sending of posture history to application
+    LogMaintenance logMaintenance;  // erasing of posture log sector ahead of time
     bool isPostureOn = true; // is posture processing enabled
+    uint8_t telemetryMask = 0; // subscribed telemetry messages, text posture verdicts are sent if it is 0
 
-    /* Vector of functions of Mithril for processing in main loop.
-     * first element  -- function
-     * second element -- state (powered on / off).
+    /* Are IMU-sensors read with their FIFO instead of DMA sampler.
+     * FIFO keeps all samples between posture evaluations for the filter.
      */
-    std::vector<std::pair<BaseFunc *, bool>> mithrilFuncs;
+    static constexpr const bool IS_SENSORS_FIFO_ON = false;
+
+    /* Periods of Mithril functions (milliseconds) */
+    static constexpr const uint32_t POSTURE_PERIOD = 100,   // posture processing (10 Hz)
+                      SENSORS_FIFO_PERIOD = 50,             // IMU-sensors FIFO draining
+                      TELEMETRY_PERIOD = 250,               // telemetry streaming (fits 9600 baud)
+                      LOG_DOWNLOAD_PERIOD = 100,            // posture log sending (fits 9600 baud)
+                      LOG_MAINTENANCE_PERIOD = 60000;       // posture log sector erasing (stalls CPU)
 
     /* Declaration of friend. This and only this external function
-     * need reqQueue. Moreover, it will put requests in this queue only, because we have
+     * need reqQueue and cmdParser. Moreover, it will put requests in this queue only, because we have
      * singletone controller. In result we avoid globalization of reqQueue.
      */
-    friend void ::HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart);
+    friend void ::UART_RxEventCallback(UART_HandleTypeDef *huart, const uint8_t *data, uint32_t len);
+
+    /* Declaration of friends. These external functions report sampler about
+     * finished I2C transfers.
+     */
+    friend void ::HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c);
+    friend void ::HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c);
+    /* Declaration of friend. This external function reports sampler about
+     * fresh data in IMU-sensors.
+     */
+    friend void ::HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin);
 
     /* Controller default constructor.
      * Constructor is private because controller is singletone.
@@ -6,20 +6,21 @@
  * Author      : Filippov Denis
  *               Tarasov Denis
  * Create date : 04.04.2020
- * Last change : 27.05.2020
+ * Last change : 18.10.2026
  ******************************/
 
 #ifndef __POSTURE_H_
 #define __POSTURE_H_
 
-#include <memory>
 #include <cmath>
-#include <vector>
 #include <array>
+#include <utility>
 
 #include "Controller/Functionality/Functionality.h"
-#include "Sensors/IMU.h"
+#include "Sensors/SensorSet.h"
 #include "Math/quater.h"
+#include "Math/fastmath.h"
+#include "Probe.h"
 
 /* Mithril namespace */
 namespace mthl
@@ -33,9 +34,20 @@ namespace mthl
     /* Posture processing by machine learning constructor.
      *
      * Arguments:
-     *  const std::vector<std::unique_ptr<IMU>> &IMUSensors -- IMU-sensor vector
+     *  const SensorSet &IMUSensors -- IMU-sensors
      */
-    PostureProcML(const std::vector<std::unique_ptr<IMU>> &IMUSensors);
+    explicit PostureProcML(const SensorSet &IMUSensors);
+
+    /* Evaluate posture function.
+     * Posture is evaluated by current angles of IMU-sensors, nothing is reported.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   true if posture is correct.
+     */
+    bool evaluate();
 
     /* Doing posture processing function.
      *
@@ -47,14 +59,18 @@ namespace mthl
      */
     void doFunction() override;
 
+    static constexpr const std::size_t REQUIRED_SENSORS = 3; // Number of used IMU-sensors
+
   private:
-    const std::vector<std::unique_ptr<IMU>> &IMUSens; // reference on IMU-Sensors vector
+    static_assert(REQUIRED_SENSORS <= SENSORS_COUNT, "Device has not enough sensors for ML posture processing");
+
+    SensorSet IMUSens; // IMU-sensors
 
     /** Ridge classifier coefficients **/
-    constexpr static float a11 = -0.22837643649834735, a12 = 0.004623785286151828,
-        a13 = -0.250472523316491, a21 = 0.0006772766899397244, a22 = 0.006967943364773297,
-        a23 = 0.1497574860779648, a41 = 0.1617428204390021, a42 = -0.08251909275653284,
-        a43 = -0.0799760851616042977, bias = -0.5213019836385582;
+    constexpr static float a11 = -0.22837643649834735f, a12 = 0.004623785286151828f,
+        a13 = -0.250472523316491f, a21 = 0.0006772766899397244f, a22 = 0.006967943364773297f,
+        a23 = 0.1497574860779648f, a41 = 0.1617428204390021f, a42 = -0.08251909275653284f,
+        a43 = -0.0799760851616042977f, bias = -0.5213019836385582f;
   }; // End of 'PostureProcML' class declaration
 
 
@@ -65,9 +81,21 @@ namespace mthl
     /* Posture processing by approximation spine to function constructor.
      *
      * Arguments:
-     *  const std::vector<std::unique_ptr<IMU>> &IMUSensors -- IMU-sensor vector
+     *  const SensorSet &IMUSensors -- IMU-sensors
+     */
+    explicit PostureProcASF(const SensorSet &IMUSensors);
+
+    /* Evaluate posture function.
+     * Posture is evaluated by current angles of IMU-sensors, spine angles are kept for
+     * 'getSpineAngles', nothing is reported.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   true if posture is correct.
      */
-    PostureProcASF(const std::vector<std::unique_ptr<IMU>> &IMUSensors);
+    bool evaluate();
 
     /* Doing posture processing function.
      *
@@ -79,8 +107,49 @@ namespace mthl
      */
     void doFunction() override;
 
+    static constexpr const uint32_t ANGLES_COUNT = 2;          // Number of checked spine angles
+    static constexpr const std::size_t REQUIRED_SENSORS = 3;   // Number of used IMU-sensors
+
+    /* Set bounds of correct spine angle function.
+     *
+     * Arguments:
+     *   uint32_t angle -- angle number (0 -- upper, 1 -- lower)
+     *   float minValue, maxValue -- bounds of correct angle (degrees)
+     *
+     * Returns:
+     *   true if bounds were set, false for wrong angle or bounds.
+     */
+    bool setBounds(uint32_t angle, float minValue, float maxValue);
+
+    /* Spine angles getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Spine angles of last evaluation (degrees).
+     */
+    const std::array<float, ANGLES_COUNT> & getSpineAngles() const;
+
   private:
-    const std::vector<std::unique_ptr<IMU>> &IMUSens; // reference on IMU-Sensors vector
+    static_assert(REQUIRED_SENSORS <= SENSORS_COUNT, "Device has not enough sensors for spine approximation");
+
+    /* Spine is approximated by points of sensors and bends between them */
+    static constexpr const std::size_t POINTS_COUNT = 2 * REQUIRED_SENSORS - 1;
+
+    SensorSet IMUSens; // IMU-sensors
+
+    /* Checked spine angle structure */
+    struct checkedAngle final
+    {
+      std::array<float, 3> dists{}; // distances along spine to angle points
+      float minValue, maxValue;     // bounds of correct angle (degrees)
+
+      bool check(float angle) const
+      {
+        return minValue <= angle && angle <= maxValue;
+      }
+    };
 
     /* Spine approximation function */
     struct spineApproxFunc final
@@ -99,8 +168,8 @@ namespace mthl
           sinRight = 0;
       };
 
-      std::vector<point> points{};
-      static constexpr float PI = 3.1415926535;
+      std::array<point, POINTS_COUNT> points{};
+      static constexpr float PI = 3.1415926535f;
 
       static float degToRad(float angleInDeg)
       {
@@ -113,23 +182,20 @@ namespace mthl
       }
 
       // don't forget that angles left have to be > pi / 2
-      void updateAngles(const std::vector<std::pair<float, float>> &angles)
+      void updateAngles(const std::array<std::pair<float, float>, POINTS_COUNT> &angles)
       {
         for (std::size_t i = 0; i < points.size(); ++i)
         {
-          points[i].cosLeft = std::cos(degToRad(angles[i].first));
-          points[i].cosRight = std::cos(degToRad(angles[i].second));
-          points[i].sinLeft = std::sin(degToRad(angles[i].first));
-          points[i].sinRight = std::sin(degToRad(angles[i].second));
+          math::fastSinCos(degToRad(angles[i].first), points[i].sinLeft, points[i].cosLeft);
+          math::fastSinCos(degToRad(angles[i].second), points[i].sinRight, points[i].cosRight);
         }
       }
 
       // distToNext[i] -- distance from points[i] to points[i + 1]
       // if angles.first === false, point is inflection point of function, else point in part of function
-      spineApproxFunc(const std::vector<float> &distToNext
-                      /*, const std::vector<std::pair<float, float>> &angles*/)
+      spineApproxFunc(const std::array<float, POINTS_COUNT> &distToNext
+                      /*, const std::array<std::pair<float, float>, POINTS_COUNT> &angles*/)
       {
-        points.resize(distToNext.size());
         for (std::size_t i = 0; i < points.size(); i++)
           points[i].distNext = distToNext[i];
         /* updateAngles(angles); */
@@ -150,7 +216,7 @@ namespace mthl
           curDist += points[i].distNext;
         }
         // points.back().distNext == 0;
-        i = std::min(points.size(), i);
+        i = std::min(points.size() - 1, i);
         curX += points[i].cosRight * (dist - curDist);
         curY += points[i].sinRight * (dist - curDist);
         return {curX, curY};
@@ -161,6 +227,7 @@ namespace mthl
       // dists between start point and that along function
       float getAngle(const std::array<float, 3> dists)
       {
+        MTHL_PROBE(SPINE_ANGLE);
         basePoint
           point1 = getPointByDistFromStart(dists[0]),
           point2 = getPointByDistFromStart(dists[1]),
@@ -169,15 +236,23 @@ namespace mthl
           vecOfAngle1 = {point1.x - point2.x, point1.y - point2.y},
           vecOfAngle2 = {point3.x - point2.x, point3.y - point2.y};
         float
-          lenVec1 = sqrt(vecOfAngle1.x * vecOfAngle1.x + vecOfAngle1.y * vecOfAngle1.y),
-          lenVec2 = sqrt(vecOfAngle2.x * vecOfAngle2.x + vecOfAngle2.y * vecOfAngle2.y);
+          lenVec1 = math::fastSqrt(vecOfAngle1.x * vecOfAngle1.x + vecOfAngle1.y * vecOfAngle1.y),
+          lenVec2 = math::fastSqrt(vecOfAngle2.x * vecOfAngle2.x + vecOfAngle2.y * vecOfAngle2.y);
 
-        return radToDeg(std::acos((vecOfAngle1.x * vecOfAngle2.x + vecOfAngle1.y * vecOfAngle2.y) /
+        return radToDeg(math::fastAcos((vecOfAngle1.x * vecOfAngle2.x + vecOfAngle1.y * vecOfAngle2.y) /
                         (lenVec1 * lenVec2)));
       }
     };
 
     spineApproxFunc SPFunc;
+    std::array<checkedAngle, ANGLES_COUNT> angles; // checked spine angles
+    std::array<float, ANGLES_COUNT> spineAngles{}; // spine angles of last evaluation (degrees)
+
+    static constexpr const uint32_t SUMMARY_PERIOD = 60000; // Period of logging mean angles (milliseconds)
+
+    std::array<float, ANGLES_COUNT> anglesSum{}; // sums of angles since last logging
+    uint32_t anglesCount = 0;                    // number of summed angles
+    uint32_t summaryStart = 0;                   // time of last logging (milliseconds)
   }; // End of 'PostureProcAF' class declaration
 } // end of 'mthl' namespace
 
@@ -0,0 +1,48 @@
+/******************************
+ * File name   : SensorsUpdate.h
+ * Purpose     : Mithril project.
+ *               Mithril functionality module.
+ *               IMU-sensors update class declaration module.
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __SENSORS_UPDATE_H_
+#define __SENSORS_UPDATE_H_
+
+#include "Controller/Functionality/Functionality.h"
+#include "Sensors/SensorSet.h"
+
+/* Mithril namespace */
+namespace mthl
+{
+  /* IMU-sensors update class declaration.
+   * Filters data collected by sensors since previous update.
+   */
+  class SensorsUpdate final : public BaseFunc
+  {
+  public:
+    /* IMU-sensors update constructor.
+     *
+     * Arguments:
+     *  const SensorSet &IMUSensors -- IMU-sensors
+     */
+    explicit SensorsUpdate(const SensorSet &IMUSensors);
+
+    /* Doing sensors update function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void doFunction() override;
+
+  private:
+    SensorSet IMUSens; // IMU-sensors
+  }; // End of 'SensorsUpdate' class declaration
+} // end of 'mthl' namespace
+
+#endif // __SENSORS_UPDATE_H_
@@ -0,0 +1,51 @@
+/******************************
+ * File name   : LogMaintenance.h
+ * Purpose     : Mithril project.
+ *               Mithril functionality module.
+ *               Posture log maintenance class declaration module.
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __LOG_MAINTENANCE_H_
+#define __LOG_MAINTENANCE_H_
+
+#include "Controller/Functionality/Functionality.h"
+#include "Storage/PostureLog.h"
+
+/* Mithril namespace */
+namespace mthl
+{
+  /* Posture log maintenance class declaration.
+   * Erases sector for next posture log entries ahead of time, so appending
+   * never waits for erasing. It runs rarely, erasing happens once per sector.
+   * Erasing stalls CPU with all interrupts, so sensors reading is paused and
+   * telemetry is sent out before it.
+   */
+  class LogMaintenance final : public BaseFunc
+  {
+  public:
+    /* Posture log maintenance constructor.
+     *
+     * Arguments:
+     *  PostureLog &log -- posture log
+     */
+    LogMaintenance(PostureLog &log);
+
+    /* Doing log maintenance function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void doFunction() override;
+
+  private:
+    PostureLog &log; // reference on posture log
+  }; // End of 'LogMaintenance' class declaration
+} // end of 'mthl' namespace
+
+#endif // __LOG_MAINTENANCE_H_
@@ -0,0 +1,65 @@
+/******************************
+ * File name   : LogDownload.h
+ * Purpose     : Mithril project.
+ *               Mithril functionality module.
+ *               Posture log downloading class declaration module.
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __LOG_DOWNLOAD_H_
+#define __LOG_DOWNLOAD_H_
+
+#include "Controller/Functionality/Functionality.h"
+#include "Storage/PostureLog.h"
+
+/* Mithril namespace */
+namespace mthl
+{
+  /* Posture log downloading class declaration.
+   * Sends posture log from the oldest entry to the newest one as LOG_ENTRIES
+   * telemetry frames. Log is sent by small portions on each run, so downloading
+   * does not occupy application link and main loop. Frame without entries ends log.
+   */
+  class LogDownload final : public BaseFunc
+  {
+  public:
+    static constexpr const uint32_t
+      ENTRIES_PER_FRAME = 3, // Number of log entries in one frame
+      FRAMES_PER_RUN = 2;    // Number of frames sent on each run
+
+    /* Posture log downloading constructor.
+     *
+     * Arguments:
+     *  PostureLog &log -- posture log
+     */
+    LogDownload(PostureLog &log);
+
+    /* Start downloading from the oldest entry function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void start();
+
+    /* Doing log downloading function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void doFunction() override;
+
+  private:
+    PostureLog &log;        // reference on posture log
+    bool isActive = false;  // is log being sent
+  }; // End of 'LogDownload' class declaration
+} // end of 'mthl' namespace
+
+#endif // __LOG_DOWNLOAD_H_
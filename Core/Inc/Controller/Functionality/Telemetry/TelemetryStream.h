@@ -0,0 +1,70 @@
+/******************************
+ * File name   : TelemetryStream.h
+ * Purpose     : Mithril project.
+ *               Mithril functionality module.
+ *               Telemetry streaming class declaration module.
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __TELEMETRY_STREAM_H_
+#define __TELEMETRY_STREAM_H_
+
+#include "Controller/Functionality/Functionality.h"
+#include "Sensors/SensorSet.h"
+#include "Telemetry/Telemetry.h"
+
+/* Mithril namespace */
+namespace mthl
+{
+  /* Telemetry streaming class declaration.
+   * Sends last raw sample and filtered angles of each IMU-sensor to application
+   * link if these messages are subscribed.
+   */
+  class TelemetryStream final : public BaseFunc
+  {
+  public:
+    /* Telemetry streaming constructor.
+     *
+     * Arguments:
+     *  const SensorSet &IMUSensors -- IMU-sensors
+     */
+    explicit TelemetryStream(const SensorSet &IMUSensors);
+
+    /* Doing telemetry streaming function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void doFunction() override;
+
+    /* Send frame to application link function.
+     *
+     * Arguments:
+     *   telemetry::Frame &frame -- frame to send
+     *
+     * Returns:
+     *   None.
+     */
+    static void send(telemetry::Frame &frame);
+
+    /* Wait till sent frames leave application link function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    static void flush();
+
+  private:
+    SensorSet IMUSens; // IMU-sensors
+  }; // End of 'TelemetryStream' class declaration
+} // end of 'mthl' namespace
+
+#endif // __TELEMETRY_STREAM_H_
@@ -0,0 +1,84 @@
+/******************************
+ * File name   : CommandParser.h
+ * Purpose     : Mithrill project.
+ *               Controller module.
+ *               Command frames parser class declaration.
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __COMMAND_PARSER_H_
+#define __COMMAND_PARSER_H_
+
+#include <stdint.h>
+
+#include "stm32f4xx_hal.h"
+
+#include "Controller/Request/Request.h"
+
+/* Mithril namespace */
+namespace mthl
+{
+  /* Command parser class declaration.
+   * Turns bytes received from application into requests one byte at a time,
+   * so it is called right from UART interrupt.
+   *
+   * Single bytes are commands without arguments, as before. Command with
+   * arguments is sent as frame: zero byte, COBS-encoded packet, zero byte.
+   * Packet is version (telemetry::VERSION), command byte, arguments and CRC16
+   * of them, the same as telemetry frames use. Broken frames are dropped and counted.
+   * Frame is also dropped when it is too long or its bytes stop coming for FRAME_TIMEOUT,
+   * so stray zero byte does not make parser swallow following commands. Bytes of too long
+   * frame are skipped till its zero byte (or pause), so they are not taken for commands.
+   */
+  class CommandParser final
+  {
+  public:
+    /* Process received byte function.
+     *
+     * Arguments:
+     *   uint8_t byte -- received byte
+     *   Request &request -- parsed request
+     *
+     * Returns:
+     *   true if request was parsed.
+     */
+    bool feed(uint8_t byte, Request &request);
+
+    /* Number of dropped frames getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Number of broken, too long or not finished frames.
+     */
+    uint32_t getErrorsCount() const;
+
+  private:
+    /* Maximal size of encoded packet: version, command, arguments, CRC and COBS code */
+    static constexpr const uint32_t MAX_FRAME_SIZE = 2 + Request::MAX_PAYLOAD_SIZE + 2 + 1;
+    /* Maximal pause between bytes of frame (milliseconds), frame is sent at once */
+    static constexpr const uint32_t FRAME_TIMEOUT = 200;
+
+    uint8_t frame[MAX_FRAME_SIZE]; // bytes of current frame
+    uint32_t frameSize = 0;        // number of bytes of current frame
+    bool isInFrame = false;        // is frame being received
+    bool isDiscarding = false;     // are bytes of too long frame skipped
+    uint32_t lastByteTime = 0;     // time of last byte of frame (milliseconds)
+    uint32_t errorsCount = 0;      // number of dropped frames
+
+    /* Decode received frame function.
+     *
+     * Arguments:
+     *   Request &request -- parsed request
+     *
+     * Returns:
+     *   true if frame is correct.
+     */
+    bool decode(Request &request);
+  }; // End of 'CommandParser' class
+} // end of 'mthl' namespace
+
+#endif // __COMMAND_PARSER_H_
@@ -5,18 +5,13 @@
  *               Request class declaration.
  * Author      : Filippov Denis
  * Create date : 09.03.2020
- * Last change : 18.05.2020
+ * Last change : 18.10.2026
  ******************************/
 
 
 #ifndef __REQUEST_H_
 #define __REQUEST_H_
 
-#include <string>
-#include <queue>
-#include <map>
-#include <functional>
-
 #include "stm32f4xx.h"
 
 /* Mithril namespace */
@@ -35,13 +30,40 @@ namespace mthl
       OK    // got request
     }; // End of 'State' enun class
 
+    /* Command function type */
+    using Handler = State (*)(const Request &request);
+
+    static constexpr const uint32_t MAX_PAYLOAD_SIZE = 8; // Maximal size of command arguments
+
     /* Request from byte constructor.
+     * Unknown bytes give request which does nothing.
      *
      * Arguments
      *   uint8_t byte -- byte of command.
      */
     Request(uint8_t byte);
 
+    /* Request with arguments constructor.
+     * Arguments which do not fit in MAX_PAYLOAD_SIZE are dropped.
+     *
+     * Arguments
+     *   uint8_t byte -- byte of command.
+     *   const uint8_t *payload -- command arguments.
+     *   uint32_t size -- size of arguments.
+     */
+    Request(uint8_t byte, const uint8_t *payload, uint32_t size);
+
+    /* Check if byte is known command function.
+     * It is safe to call it from interrupt.
+     *
+     * Arguments:
+     *   uint8_t byte -- byte to check.
+     *
+     * Returns:
+     *   true if byte is command.
+     */
+    static bool isCommand(uint8_t byte);
+
     /* Doing command from request function.
      *
      * Arguments:
@@ -52,28 +74,54 @@ namespace mthl
      */
     State doCommand() const;
 
-  private:
-    /* Request command enum class declaration */
+    /* Command arguments getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Pointer to arguments bytes.
+     */
+    const uint8_t * getPayload() const;
+
+    /* Command arguments size getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Size of arguments.
+     */
+    uint32_t getPayloadSize() const;
+
+    /* Request command enum class declaration.
+     * Values are bytes of commands. Commands with arguments can be sent in
+     * command frames only (see CommandParser), arguments are little-endian.
+     */
     enum class Command : uint8_t
     {
-      POWER_ON_LED,
-      POWER_OFF_LED,
-      POSTURE_ON,
-      POSTURE_OFF,
-      CALIBRATE
+      POWER_ON_LED = '1',
+      POWER_OFF_LED = '2',
+      POSTURE_ON = 'P',
+      POSTURE_OFF = 'D',
+      CALIBRATE = 'C',
+      SLEEP_STATS = 'S',
+      TELEMETRY_ON = 'T',
+      TELEMETRY_OFF = 'E',
+      LINK_STATS = 'L',
+      LOG_DOWNLOAD = 'H',
+      PROBES = 'R',                 // timing probes output, available if probes are built
+      BENCHMARKS = 'B',             // math microbenchmarks, available if probes are built
+      SET_POSTURE_BOUNDS = 0x80,    // angle (u8), minimum and maximum (2 x i16, 0.01 degree)
+      SET_FILTER_TIME_CONST = 0x81, // complementary filter time constant (u16, milliseconds)
+      SET_SAMPLE_PERIOD = 0x82,     // IMU-sensors sampling period (u16, milliseconds)
+      SET_TELEMETRY = 0x83          // telemetry subscription (u8, bit per message type)
     }; // End of 'Command' enum class
 
-    Command command; // command of this request
-
-    /* Map who mathes byte and it command */
-    static std::map<uint8_t, Command> fromByteToCmdMap;
-    /* Map who matches commands and their function */
-    static std::map<Command, std::function<State(void)>> fromCmdToFuncMap;
-
-    /* Declaration of friend. This and only this external function
-     * need Request private field.
-     */
-    friend void ::HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart);
+  private:
+    uint8_t byte;                       // byte of command of this request
+    uint8_t payloadSize = 0;            // size of command arguments
+    uint8_t payload[MAX_PAYLOAD_SIZE];  // command arguments
   }; // End of 'Request' class
 } // end of 'mthl' namespace
 
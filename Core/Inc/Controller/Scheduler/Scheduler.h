@@ -0,0 +1,117 @@
+/******************************
+ * File name   : Scheduler.h
+ * Purpose     : Mithrill project.
+ *               Controller module.
+ *               Periodic cooperative tasks scheduler class declaration.
+ * Author      : Filippov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __SCHEDULER_H_
+#define __SCHEDULER_H_
+
+#include <array>
+
+#include "stm32f4xx_hal.h"
+
+#include "Controller/Functionality/Functionality.h"
+
+/* Mithril namespace */
+namespace mthl
+{
+  /* Scheduler class declaration.
+   * Runs Mithril functions with their own periods. Time is taken from SysTick
+   * (milliseconds). Tasks are kept ordered by release time, so the earliest one
+   * is always first. Task is not interrupted by others, so if it finishes after
+   * its deadline or skips whole periods, deadline miss is recorded.
+   */
+  class Scheduler final
+  {
+  public:
+    static constexpr const std::size_t MAX_TASKS = 8; // Maximal number of tasks
+
+    /* Add periodic task function.
+     *
+     * Arguments:
+     *   BaseFunc *func -- function to run
+     *   uint32_t period -- time between runs (milliseconds), must not be zero
+     *   uint32_t deadline -- time since release to finish run (milliseconds),
+     *                        0 means deadline equal to period
+     *   uint32_t delay -- time to first release (milliseconds)
+     *
+     * Returns:
+     *   true if task was added, false if there is no place for it.
+     */
+    bool addTask(BaseFunc *func, uint32_t period, uint32_t deadline = 0, uint32_t delay = 0);
+
+    /* Run all released tasks function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Number of tasks which were run.
+     */
+    uint32_t run();
+
+    /* Time to next release getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Time to release of first task (milliseconds), 0 if it is already released,
+     *   HAL_MAX_DELAY if there are no tasks.
+     */
+    uint32_t getTimeToNext() const;
+
+    /* Number of missed deadlines getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Number of missed deadlines of all tasks.
+     */
+    uint32_t getMissesCount() const;
+
+  private:
+    /* Periodic task structure */
+    struct Task
+    {
+      BaseFunc *func = nullptr; // function to run
+      uint32_t period = 0;      // time between runs (milliseconds)
+      uint32_t deadline = 0;    // time since release to finish run (milliseconds)
+      uint32_t release = 0;     // time of next release (milliseconds)
+    }; // End of 'Task' structure
+
+    std::array<Task, MAX_TASKS> tasks{}; // tasks ordered by release time
+    std::size_t tasksCount = 0;          // number of tasks
+    uint32_t missesCount = 0;            // number of missed deadlines
+
+    /* Check if time is reached function. Tick counter overflow is handled.
+     *
+     * Arguments:
+     *   uint32_t time -- time to check
+     *   uint32_t now -- current time
+     *
+     * Returns:
+     *   true if time is not later than current.
+     */
+    static bool isReached(uint32_t time, uint32_t now);
+
+    /* Put task to its place by release time function.
+     * Tasks with equal release time are run in order of putting.
+     *
+     * Arguments:
+     *   const Task &task -- task to put
+     *
+     * Returns:
+     *   None.
+     */
+    void insert(const Task &task);
+  }; // End of 'Scheduler' class
+} // end of 'mthl' namespace
+
+#endif /* __SCHEDULER_H_ */
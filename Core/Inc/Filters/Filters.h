@@ -5,7 +5,7 @@
  *
  * Author      : Tarasov Denis
  * Create date : 31.03.2020
- * Last change : 01.04.2020
+ * Last change : 18.10.2026
  ******************************/
 
 #ifndef __FILTERS_H_
@@ -17,6 +17,14 @@
 namespace mthl {
   namespace filters
   {
+    /* Orientation filter type enum class declaration */
+    enum class Type : uint8_t
+    {
+      COMPLEMENTARY, // complementary filter of angles
+      MADGWICK,      // Madgwick gradient descent quaternion filter
+      MAHONY         // Mahony proportional-integral quaternion filter
+    }; // End of 'Type' enum class
+
     /* Complementary filter function.
      * Arguments:
      *   quater prev -- old angles state
@@ -30,6 +38,67 @@ namespace mthl {
      */
     math::quater<float> complementary(math::quater<float> prev, math::quater<float> gyro,
         math::quater<float> accel, float dtime, float delta);
+
+    /* Complementary filter delta evaluation function.
+     * Filter with this delta has the same behaviour for any time between samples.
+     * Arguments:
+     *   float dtime -- time passed
+     *   float timeConst -- filter time constant (seconds)
+     *
+     * Returns:
+     *   Delta value for the filter.
+     */
+    float complementaryDelta(float dtime, float timeConst);
+
+    /* Madgwick filter function.
+     * Arguments:
+     *   quater q -- old orientation quaternion
+     *   quater gyro -- data from gyroscope (degrees per second)
+     *   quater accel -- data from accelerometer
+     *   float dtime -- time passed
+     *   float beta -- gradient descent step gain
+     *
+     * Returns:
+     *   New orientation quaternion.
+     */
+    math::quater<float> madgwick(math::quater<float> q, math::quater<float> gyro,
+        math::quater<float> accel, float dtime, float beta);
+
+    /* Mahony filter function.
+     * Arguments:
+     *   quater q -- old orientation quaternion
+     *   quater gyro -- data from gyroscope (degrees per second)
+     *   quater accel -- data from accelerometer
+     *   float dtime -- time passed
+     *   float kp -- proportional gain
+     *   float ki -- integral gain
+     *   vec &integral -- integral of error, updated by the filter
+     *
+     * Returns:
+     *   New orientation quaternion.
+     */
+    math::quater<float> mahony(math::quater<float> q, math::quater<float> gyro,
+        math::quater<float> accel, float dtime, float kp, float ki, math::vec<float> &integral);
+
+    /* Orientation from accelerometer data evaluation function.
+     * Rotation around gravity vector is taken zero.
+     * Arguments:
+     *   quater accel -- data from accelerometer
+     *
+     * Returns:
+     *   Orientation quaternion.
+     */
+    math::quater<float> orientationFromAccel(math::quater<float> accel);
+
+    /* Orientation quaternion to angles conversion function.
+     * Angles are the same as complementary filter gives.
+     * Arguments:
+     *   quater q -- orientation quaternion
+     *
+     * Returns:
+     *   Angles in degrees.
+     */
+    math::quater<float> orientationToAngles(math::quater<float> q);
   } // end of 'filters' namespace
 }  // end of 'mthl' namespace
 
@@ -0,0 +1,248 @@
+/******************************
+ * File name   : fastmath.h
+ * Purpose     : Mithril project.
+ *               Fast single precision math functions approximations
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __FASTMATH_H_
+#define __FASTMATH_H_
+
+#include <stdint.h>
+
+/* Mithril namespace */
+namespace mthl
+{
+  namespace math
+  {
+    /* Functions use only single precision operations, so they are evaluated by FPU
+     * without calls to double precision library functions. They are constexpr and
+     * can be evaluated by compiler for constant arguments. Maximal absolute errors
+     * (radians for angles) measured over whole range of arguments:
+     *
+     *   function    | range          | maximal error
+     *   ------------+----------------+--------------
+     *   fastSqrt    | [0, +inf)      | exact (FPU instruction)
+     *   fastAtan2   | any y, x       | 2.0e-6
+     *   fastSinCos  | [-10, 10]      | 1.0e-6
+     *   fastSinCos  | [-100, 100]    | 6.0e-6 (range reduction error grows with x)
+     *   fastAcos    | [-1, 1]        | 7.0e-5
+     *
+     * Bounds are checked by 'fastmath' test of Host/Src/MathTest.cpp. Double precision
+     * overloads below are library functions, they keep precision of vec<double> and
+     * quater<double>.
+     */
+    static constexpr const float
+      FAST_PI = 3.14159265f,                 // pi
+      FAST_HALF_PI = 1.57079633f,            // pi / 2
+      FAST_TWO_PI = 6.28318531f,             // 2 * pi
+      FAST_ATAN2_MAX_ERROR = 2.0e-6f,        // maximal error of fastAtan2
+      FAST_SINCOS_MAX_ERROR = 6.0e-6f,       // maximal error of fastSinCos in [-100, 100]
+      FAST_ACOS_MAX_ERROR = 7.0e-5f;         // maximal error of fastAcos
+
+    /* Square root function.
+     * Arguments:
+     *   float x -- argument
+     *
+     * Returns:
+     *   Square root of x, 0 for negative x.
+     */
+    constexpr float fastSqrt(float x)
+    {
+      // Guard lets compiler emit single VSQRT without errno processing
+      if (x <= 0)
+        return 0;
+      return __builtin_sqrtf(x);
+    } // End of 'fastSqrt' function
+
+    /* Arctangent of two arguments function.
+     * Arguments:
+     *   float y, x -- point coordinates
+     *
+     * Returns:
+     *   Angle of point in range [-pi, pi].
+     */
+    constexpr float fastAtan2(float y, float x)
+    {
+      float ax = x < 0 ? -x : x, ay = y < 0 ? -y : y;
+
+      if (ax == 0 && ay == 0)
+        return 0;
+
+      // Polynomial is evaluated for ratio in [0, 1]
+      bool isSwapped = ay > ax;
+      float
+        z = isSwapped ? ax / ay : ay / ax,
+        z2 = z * z,
+        a = z * (0.99997726f + z2 * (-0.33262347f + z2 * (0.19354346f + z2 * (-0.11643287f +
+            z2 * (0.05265332f + z2 * -0.01172120f)))));
+
+      if (isSwapped)
+        a = FAST_HALF_PI - a;
+      if (x < 0)
+        a = FAST_PI - a;
+      return y < 0 ? -a : a;
+    } // End of 'fastAtan2' function
+
+    /* Sine and cosine evaluation function.
+     * Arguments:
+     *   float x -- angle in radians
+     *   float &s -- sine of angle
+     *   float &c -- cosine of angle
+     *
+     * Returns:
+     *   None.
+     */
+    constexpr void fastSinCos(float x, float &s, float &c)
+    {
+      // Reduce angle to [-pi, pi]
+      float k = x * (1 / FAST_TWO_PI);
+
+      k = (float)(int32_t)(k < 0 ? k - 0.5f : k + 0.5f);
+      x -= k * FAST_TWO_PI;
+
+      // Reduce angle to [-pi / 2, pi / 2], cosine changes sign
+      float sign = 1;
+
+      if (x > FAST_HALF_PI)
+      {
+        x = FAST_PI - x;
+        sign = -1;
+      }
+      else if (x < -FAST_HALF_PI)
+      {
+        x = -FAST_PI - x;
+        sign = -1;
+      }
+
+      float x2 = x * x;
+
+      s = x * (1 + x2 * (-1.66666667e-1f + x2 * (8.33333333e-3f + x2 * (-1.98412698e-4f +
+          x2 * (2.75573192e-6f + x2 * -2.50521084e-8f)))));
+      c = sign * (1 + x2 * (-0.5f + x2 * (4.16666667e-2f + x2 * (-1.38888889e-3f +
+          x2 * (2.48015873e-5f + x2 * (-2.75573192e-7f + x2 * 2.08767570e-9f))))));
+    } // End of 'fastSinCos' function
+
+    /* Sine function.
+     * Arguments:
+     *   float x -- angle in radians
+     *
+     * Returns:
+     *   Sine of angle.
+     */
+    constexpr float fastSin(float x)
+    {
+      float s = 0, c = 0;
+
+      fastSinCos(x, s, c);
+      return s;
+    } // End of 'fastSin' function
+
+    /* Cosine function.
+     * Arguments:
+     *   float x -- angle in radians
+     *
+     * Returns:
+     *   Cosine of angle.
+     */
+    constexpr float fastCos(float x)
+    {
+      float s = 0, c = 0;
+
+      fastSinCos(x, s, c);
+      return c;
+    } // End of 'fastCos' function
+
+    /* Arccosine function.
+     * Arguments:
+     *   float x -- argument, it is clamped to [-1, 1]
+     *
+     * Returns:
+     *   Angle in range [0, pi].
+     */
+    constexpr float fastAcos(float x)
+    {
+      bool isNegative = x < 0;
+
+      if (isNegative)
+        x = -x;
+      if (x > 1)
+        x = 1;
+
+      // Abramowitz and Stegun 4.4.45
+      float a = fastSqrt(1 - x) * (1.5707288f + x * (-0.2121144f + x * (0.0742610f +
+          x * -0.0187293f)));
+
+      return isNegative ? FAST_PI - a : a;
+    } // End of 'fastAcos' function
+
+    /* Double precision square root function.
+     * Arguments:
+     *   double x -- argument
+     *
+     * Returns:
+     *   Square root of x, 0 for negative x.
+     */
+    constexpr double fastSqrt(double x)
+    {
+      if (x <= 0)
+        return 0;
+      return __builtin_sqrt(x);
+    } // End of 'fastSqrt' function
+
+    /* Double precision arctangent of two arguments function.
+     * Arguments:
+     *   double y, x -- point coordinates
+     *
+     * Returns:
+     *   Angle of point in range [-pi, pi].
+     */
+    constexpr double fastAtan2(double y, double x)
+    {
+      return __builtin_atan2(y, x);
+    } // End of 'fastAtan2' function
+
+    /* Double precision sine and cosine evaluation function.
+     * Arguments:
+     *   double x -- angle in radians
+     *   double &s -- sine of angle
+     *   double &c -- cosine of angle
+     *
+     * Returns:
+     *   None.
+     */
+    constexpr void fastSinCos(double x, double &s, double &c)
+    {
+      s = __builtin_sin(x);
+      c = __builtin_cos(x);
+    } // End of 'fastSinCos' function
+
+    /* Double precision sine function.
+     * Arguments:
+     *   double x -- angle in radians
+     *
+     * Returns:
+     *   Sine of angle.
+     */
+    constexpr double fastSin(double x)
+    {
+      return __builtin_sin(x);
+    } // End of 'fastSin' function
+
+    /* Double precision arccosine function.
+     * Arguments:
+     *   double x -- argument, it is clamped to [-1, 1]
+     *
+     * Returns:
+     *   Angle in range [0, pi].
+     */
+    constexpr double fastAcos(double x)
+    {
+      return __builtin_acos(x < -1 ? -1 : x > 1 ? 1 : x);
+    } // End of 'fastAcos' function
+  } // end of 'math' namespace
+} // end of 'mthl' namespace
+
+#endif // __FASTMATH_H_
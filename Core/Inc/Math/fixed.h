@@ -0,0 +1,247 @@
+/******************************
+ * File name   : fixed.h
+ * Purpose     : Mithril project.
+ *               Fixed point number
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __FIXED_H_
+#define __FIXED_H_
+
+#include <stdint.h>
+
+/* Mithril namespace */
+namespace mthl
+{
+  namespace math
+  {
+    /* fixed class
+     * Signed Q16.16 fixed point number: range [-32768, 32768), step 1 / 65536.
+     * It can be used as 'Type' of vec and quater, operations are integer only and constexpr.
+     * Overflow is not checked.
+     */
+    class fixed
+    {
+    public:
+      static constexpr const int32_t FRACTION_BITS = 16;            // number of fraction bits
+      static constexpr const int32_t ONE = 1 << FRACTION_BITS;      // raw value of 1
+
+      /* Fixed point number constructor.
+       * Arguments: None.
+       */
+      constexpr fixed() : raw(0)
+      {
+      } // End of 'fixed' constructor
+
+      /* Fixed point number from integer constructor.
+       * Arguments:
+       *   int32_t n -- integer number
+       */
+      constexpr fixed(int32_t n) : raw(n * ONE)
+      {
+      } // End of 'fixed' constructor
+
+      /* Fixed point number from float constructor.
+       * Arguments:
+       *   float f -- number, it is rounded to nearest
+       */
+      constexpr fixed(float f) : raw(static_cast<int32_t>(f * ONE + (f < 0 ? -0.5f : 0.5f)))
+      {
+      } // End of 'fixed' constructor
+
+      /* Fixed point number from raw value creation function.
+       * Arguments:
+       *   int32_t raw -- raw value (number multiplied by ONE)
+       *
+       * Returns:
+       *   Fixed point number.
+       */
+      static constexpr fixed fromRaw(int32_t raw)
+      {
+        fixed f;
+
+        f.raw = raw;
+        return f;
+      } // End of 'fromRaw' function
+
+      /* Raw value getter.
+       * Arguments: None.
+       *
+       * Returns:
+       *   Number multiplied by ONE.
+       */
+      constexpr int32_t getRaw() const
+      {
+        return raw;
+      } // End of 'getRaw' function
+
+      /* Float conversion operator.
+       * Arguments: None.
+       *
+       * Returns:
+       *   Number as float.
+       */
+      constexpr explicit operator float() const
+      {
+        return static_cast<float>(raw) * (1.0f / ONE);
+      } // End of 'operator float' function
+
+      /* operator- overload function.
+       * Arguments: None.
+       *
+       * Returns:
+       *   Negative number.
+       */
+      constexpr fixed operator-() const
+      {
+        return fromRaw(-raw);
+      } // End of 'operator-' function
+
+      /* operator+= overload function.
+       * Arguments:
+       *   fixed f -- number to add
+       *
+       * Returns:
+       *   Result of sum
+       */
+      constexpr fixed & operator+=(const fixed &f)
+      {
+        raw += f.raw;
+        return *this;
+      } // End of 'operator+=' function
+
+      /* operator-= overload function.
+       * Arguments:
+       *   fixed f -- number to substract
+       *
+       * Returns:
+       *   Result of substraction
+       */
+      constexpr fixed & operator-=(const fixed &f)
+      {
+        raw -= f.raw;
+        return *this;
+      } // End of 'operator-=' function
+
+      /* operator*= overload function.
+       * Arguments:
+       *   fixed f -- number to multiply with
+       *
+       * Returns:
+       *   Result of multiplication
+       */
+      constexpr fixed & operator*=(const fixed &f)
+      {
+        raw = static_cast<int32_t>(static_cast<int64_t>(raw) * f.raw >> FRACTION_BITS);
+        return *this;
+      } // End of 'operator*=' function
+
+      /* operator/= overload function.
+       * Arguments:
+       *   fixed f -- number to devide on
+       *
+       * Returns:
+       *   Result of division, 0 if f is 0
+       */
+      constexpr fixed & operator/=(const fixed &f)
+      {
+        raw = f.raw == 0 ? 0 : static_cast<int32_t>(static_cast<int64_t>(raw) * ONE / f.raw);
+        return *this;
+      } // End of 'operator/=' function
+
+      /* Arithmetic operators (numbers of other types are converted to fixed) */
+      friend constexpr fixed operator+(fixed a, const fixed &b)
+      {
+        return a += b;
+      } // End of 'operator+' function
+
+      friend constexpr fixed operator-(fixed a, const fixed &b)
+      {
+        return a -= b;
+      } // End of 'operator-' function
+
+      friend constexpr fixed operator*(fixed a, const fixed &b)
+      {
+        return a *= b;
+      } // End of 'operator*' function
+
+      friend constexpr fixed operator/(fixed a, const fixed &b)
+      {
+        return a /= b;
+      } // End of 'operator/' function
+
+      /* Comparison operators */
+      friend constexpr bool operator==(const fixed &a, const fixed &b)
+      {
+        return a.raw == b.raw;
+      } // End of 'operator==' function
+
+      friend constexpr bool operator!=(const fixed &a, const fixed &b)
+      {
+        return a.raw != b.raw;
+      } // End of 'operator!=' function
+
+      friend constexpr bool operator<(const fixed &a, const fixed &b)
+      {
+        return a.raw < b.raw;
+      } // End of 'operator<' function
+
+      friend constexpr bool operator<=(const fixed &a, const fixed &b)
+      {
+        return a.raw <= b.raw;
+      } // End of 'operator<=' function
+
+      friend constexpr bool operator>(const fixed &a, const fixed &b)
+      {
+        return a.raw > b.raw;
+      } // End of 'operator>' function
+
+      friend constexpr bool operator>=(const fixed &a, const fixed &b)
+      {
+        return a.raw >= b.raw;
+      } // End of 'operator>=' function
+
+    private:
+      int32_t raw; // number multiplied by ONE
+    }; // End of 'fixed' class
+
+    /* Square root function.
+     * Digit by digit integer method, result is exact to the last fraction bit.
+     *
+     * Arguments:
+     *   fixed x -- argument
+     *
+     * Returns:
+     *   Square root of x, 0 for negative x.
+     */
+    constexpr fixed fastSqrt(fixed x)
+    {
+      if (x <= 0)
+        return 0;
+
+      // sqrt(raw / ONE) * ONE = sqrt(raw * ONE)
+      uint64_t op = static_cast<uint64_t>(x.getRaw()) << fixed::FRACTION_BITS, res = 0, bit = 1ull << 46;
+
+      while (bit > op)
+        bit >>= 2;
+      while (bit != 0)
+      {
+        if (op >= res + bit)
+        {
+          op -= res + bit;
+          res = (res >> 1) + bit;
+        }
+        else
+          res >>= 1;
+        bit >>= 2;
+      }
+      return fixed::fromRaw(static_cast<int32_t>(res));
+    } // End of 'fastSqrt' function
+  } // end of 'math' namespace
+} // end of 'mthl' namespace
+
+#endif // __FIXED_H_
+
+/* END OF 'FIXED.H' FILE */
@@ -4,12 +4,14 @@
  *               Quaternion
  * Author      : Tarasov Denis
  * Create date : 31.03.2020
- * Last change : 31.03.2020
+ * Last change : 18.10.2026
  ******************************/
 
 #ifndef __QUATER_H_
 #define __QUATER_H_
 
+#include <type_traits>
+
 #include "vec.h"
 
  /* Mithril namespace */
@@ -18,12 +20,16 @@ namespace mthl
   namespace math
   {
     /* quater class
-     * Quaternion
+     * Quaternion. Angles of double quaternions are evaluated in double precision,
+     * angles of other ones (float, fixed) with single precision fast functions.
      */
     template<class Type = float>
     class quater
     {
     private:
+      /* Type of angles evaluation */
+      using Real = typename std::conditional<std::is_same<Type, double>::value, double, float>::type;
+
       Type a; // Real number
       vec<Type> vector;
 
@@ -32,7 +38,7 @@ namespace mthl
        * Arguments:
        *   Type a, b, c, d -- quaternion coordinates
        */
-      quater(const Type &a, const Type &b, const Type &c, const Type &d) : a(a), vector(b, c, d)
+      constexpr quater(const Type &a, const Type &b, const Type &c, const Type &d) : a(a), vector(b, c, d)
       {
 
       } // End of 'quater' constructor
@@ -41,7 +47,7 @@ namespace mthl
        * Arguments:
        *   Type a, b, c -- quaternion coordinates
        */
-      quater(const Type &a, const Type &b, const Type &c) : a(a), vector(b, c)
+      constexpr quater(const Type &a, const Type &b, const Type &c) : a(a), vector(b, c)
       {
 
       } // End of 'quater' constructor
@@ -50,7 +56,7 @@ namespace mthl
        * Arguments:
        *   Type a, b -- quaternion coordinates
        */
-      quater(const Type &a, const Type &b) : a(a), vector(b)
+      constexpr quater(const Type &a, const Type &b) : a(a), vector(b)
       {
 
       } // End of 'quater' constructor
@@ -59,7 +65,7 @@ namespace mthl
        * Arguments:
        *    Type a -- quaternion coordinates
        */
-      explicit quater(const Type & a = 0) : a(a), vector(a)
+      constexpr explicit quater(const Type & a = 0) : a(a), vector(a)
       {
 
       } // End of 'quater' constructor
@@ -69,7 +75,7 @@ namespace mthl
        *   Type a -- real part
        *   vec<Type> v -- vector part
        */
-      quater(const Type &a, const vec<Type> &b) : a(a), vector(b)
+      constexpr quater(const Type &a, const vec<Type> &b) : a(a), vector(b)
       {
 
       } // End of 'quater' constructor
@@ -78,7 +84,7 @@ namespace mthl
        * Arguments:
        *   vec v -- quaternion to copy
        */
-      quater(const quater<Type> &q) : a(q.a), vector(q.vector)
+      constexpr quater(const quater<Type> &q) : a(q.a), vector(q.vector)
       {
 
       } // End of 'quater' constructor
@@ -89,7 +95,7 @@ namespace mthl
        * Returns:
        *   Quaternion coordinate with given number.
        */
-      Type operator[](int32_t i) const
+      constexpr Type operator[](int32_t i) const
       {
         if (i < 0)
           i = 0;
@@ -108,7 +114,7 @@ namespace mthl
        * Returns:
        *   Quaternion coordinate with given number.
        */
-      Type & operator[](int32_t i)
+      constexpr Type & operator[](int32_t i)
       {
         if (i < 0)
           i = 0;
@@ -127,9 +133,9 @@ namespace mthl
        * Returns:
        *   Quaternion length.
        */
-      Type operator!() const
+      constexpr Type operator!() const
       {
-        return sqrt(a * a + vector.lengthSquared());
+        return fastSqrt(a * a + vector.lengthSquared());
       } // End of 'operator!' function
 
 
@@ -140,9 +146,11 @@ namespace mthl
        * Returns:
        *   Production of two quaternions.
        */
-      quater<Type> operator*(const quater<Type> & q) const
+      constexpr quater<Type> operator*(const quater<Type> & q) const
       {
-        return quater(a * q.a - (vector & q.vector), q.vector * a + vector * q.a + vector % q.vector);
+        quater<Type> r(*this);
+
+        return r *= q;
       } // End of 'operator*' function
 
       /* operator* overload function.
@@ -152,7 +160,7 @@ namespace mthl
        * Returns:
        *   Production of quaternion and number.
        */
-      quater<Type> operator*(const Type &c) const
+      constexpr quater<Type> operator*(const Type &c) const
       {
         return quater(a * c, vector * c);
       } // End of 'operator*' function
@@ -164,7 +172,7 @@ namespace mthl
        * Returns:
        *   Sum of quaternions
        */
-      quater<Type> operator+(const quater<Type> &q) const
+      constexpr quater<Type> operator+(const quater<Type> &q) const
       {
         return quater<Type>(a + q.a, vector + q.vector);
       } // End of 'operator+' function
@@ -176,7 +184,7 @@ namespace mthl
        * Returns:
        *   Divided quaternion
        */
-      quater<Type> operator/(const Type &c) const
+      constexpr quater<Type> operator/(const Type &c) const
       {
         if (c == 0)
           return quater<Type>();
@@ -190,7 +198,7 @@ namespace mthl
        * Returns:
        *   Sum of quaternions
        */
-      quater<Type> operator-(const quater<Type> &q) const
+      constexpr quater<Type> operator-(const quater<Type> &q) const
       {
         return quater<Type>(a - q.a, vector - q.vector);
       } // End of 'operator-' function
@@ -201,7 +209,7 @@ namespace mthl
        * Returns:
        *   Inverse quanternion
        */
-      quater<Type> operator-() const
+      constexpr quater<Type> operator-() const
       {
         return quater<Type>(-a, -vector);
       } // End of 'operator-' function
@@ -213,7 +221,7 @@ namespace mthl
        * Returns:
        *   Result of multiplication
        */
-      quater<Type> & operator*=(const Type &c)
+      constexpr quater<Type> & operator*=(const Type &c)
       {
         a *= c;
         vector *= c;
@@ -228,7 +236,7 @@ namespace mthl
        * Returns:
        *   Result of sum
        */
-      quater<Type> & operator+=(const quater<Type> &q)
+      constexpr quater<Type> & operator+=(const quater<Type> &q)
       {
         a += q.a;
         vector += q.vector;
@@ -243,11 +251,9 @@ namespace mthl
        * Returns:
        *   Result of multiplication
        */
-      quater<Type> & operator*=(const quater<Type> &q)
+      constexpr quater<Type> & operator*=(const quater<Type> &q)
       {
-        *this = quater(a * q.a - (vector & q.vector), q.vector * a + vector * q.a + vector % q.vector);
-
-        return *this;
+        return multiply(q.a, q.vector[0], q.vector[1], q.vector[2]);
       } // End of 'operator*=' function
 
       /* operator- overload function.
@@ -257,7 +263,7 @@ namespace mthl
        * Returns:
        *   Result of substraction
        */
-      quater<Type> & operator-=(const quater<Type> &q)
+      constexpr quater<Type> & operator-=(const quater<Type> &q)
       {
         a -= q.a;
         vector -= q.vector;
@@ -272,7 +278,7 @@ namespace mthl
        * Returns:
        *   Result of division
        */
-      quater<Type> & operator/=(const Type &c)
+      constexpr quater<Type> & operator/=(const Type &c)
       {
         a /= c;
         vector /= c;
@@ -286,7 +292,7 @@ namespace mthl
        * Returns:
        *   Normalized vector
        */
-      quater<Type> normalize() const
+      constexpr quater<Type> normalize() const
       {
         return *this / !(*this);
       } // End of 'Normalize' function
@@ -297,7 +303,7 @@ namespace mthl
        * Returns:
        *   Quaternion squared length.
        */
-      Type lengthSquared() const
+      constexpr Type lengthSquared() const
       {
         return a * a + vector.lengthSquared();
       } // End of 'LengthSquared' function
@@ -308,7 +314,7 @@ namespace mthl
        * Returns:
        *   Conjugate element.
        */
-      quater<Type> conjugate() const
+      constexpr quater<Type> conjugate() const
       {
         return quater(a, -vector);
       } // End of 'conjugate' function
@@ -320,23 +326,25 @@ namespace mthl
        * Returns:
        *   Reciprocal element.
        */
-      quater<Type> reciprocal() const
+      constexpr quater<Type> reciprocal() const
       {
         if (a == 0 && vector.lengthSquared() == 0)
           return quater();
         return conjugate() / lengthSquared();
       } // End of 'reciprocal' function
 
-       /* operator/ overload function.
+      /* operator/ overload function.
        * Arguments:
        *   quater q -- quternion to devide
        *
        * Returns:
        *   Division result
        */
-      quater<Type> operator/(const quater<Type> &q) const
+      constexpr quater<Type> operator/(const quater<Type> &q) const
       {
-        return *this * q.reciprocal();
+        quater<Type> r(*this);
+
+        return r /= q;
       } // End of 'operator/' function
 
       /* operator/= overload function.
@@ -346,10 +354,17 @@ namespace mthl
        * Returns:
        *   Division result
        */
-      quater<Type> & operator/=(const quater<Type> &q)
+      constexpr quater<Type> & operator/=(const quater<Type> &q)
       {
-        *this *= q.reciprocal();
-        return *this;
+        Type length2 = q.lengthSquared();
+
+        // Production with zero reciprocal of zero quaternion
+        if (length2 == 0)
+          return *this = quater<Type>();
+
+        Type inverse = Type(1) / length2;
+
+        return multiply(q.a * inverse, -q.vector[0] * inverse, -q.vector[1] * inverse, -q.vector[2] * inverse);
       } // End of 'operator/=' function
 
       /* Sign function.
@@ -358,7 +373,7 @@ namespace mthl
        * Returns:
        *   Quaternion sign
        */
-      quater<Type> sign() const
+      constexpr quater<Type> sign() const
       {
         return *this / !(*this);
       } // End of 'sign' function
@@ -369,9 +384,9 @@ namespace mthl
        * Returns:
        *   Quaternion argument
        */
-      Type arg() const
+      constexpr Type arg() const
       {
-        return acosf(a / !(*this));
+        return Type(fastAcos(static_cast<Real>(a / !(*this))));
       } // End of 'sign' function
 
       /* operator& overload function.
@@ -381,9 +396,9 @@ namespace mthl
        * Returns:
        *   Dot production of two quaternions.
        */
-      Type operator&(const quater<Type> & q) const
+      constexpr Type operator&(const quater<Type> & q) const
       {
-        return ((conjugate() * q + q.conjugate() * (*this)) / 2).a;
+        return a * q.a + (vector & q.vector);
       } // End of 'operator&' function
 
       /* operator% overload function.
@@ -393,12 +408,11 @@ namespace mthl
        * Returns:
        *   Cross production of two quaternions.
        */
-      quater<Type> operator%(const quater<Type> & q) const
+      constexpr quater<Type> operator%(const quater<Type> & q) const
       {
-        return ((*this) * q - q * (*this)) / 2;
+        return quater<Type>(Type(0), vector % q.vector);
       } // End of 'operator%' function
 
-
       /* operator%= overload function.
        * Arguments:
        *   quater q -- quater to multiply with
@@ -406,10 +420,139 @@ namespace mthl
        * Returns:
        *   Cross production of two quaternions.
        */
-      quater<Type> & operator%=(const quater<Type> & q)
+      constexpr quater<Type> & operator%=(const quater<Type> & q)
       {
-        return *this = ((*this) * q - q * (*this)) / 2;
+        a = 0;
+        vector = vector % q.vector;
+        return *this;
       } // End of 'operator%=' function
+
+      /* Rotate vector function.
+       * Sandwich production q * v * q^-1 of unit quaternion is evaluated as
+       * v + 2w(u x v) + u x 2(u x v), where w and u are real and vector parts.
+       *
+       * Arguments:
+       *   vec v -- vector to rotate
+       *
+       * Returns:
+       *   Rotated vector.
+       */
+      constexpr vec<Type> rotate(const vec<Type> &v) const
+      {
+        vec<Type> t = (vector % v) * Type(2);
+
+        return v + t * a + vector % t;
+      } // End of 'rotate' function
+
+      /* Euler angles of rotation function.
+       * Rotation is yaw around z, then pitch around y, then roll around x (aerospace order).
+       *
+       * Arguments: None.
+       *
+       * Returns:
+       *   Roll, pitch and yaw angles in radians.
+       */
+      constexpr vec<Type> toEuler() const
+      {
+        Real
+          w = static_cast<Real>(a),
+          x = static_cast<Real>(vector[0]),
+          y = static_cast<Real>(vector[1]),
+          z = static_cast<Real>(vector[2]),
+          sinPitch = 2 * (w * y - z * x);
+
+        // Gimbal lock gives pitch of +-pi / 2
+        if (sinPitch > 1)
+          sinPitch = 1;
+        else if (sinPitch < -1)
+          sinPitch = -1;
+        return vec<Type>(
+            Type(fastAtan2(2 * (w * x + y * z), 1 - 2 * (x * x + y * y))),
+            Type(fastAtan2(sinPitch, fastSqrt(1 - sinPitch * sinPitch))),
+            Type(fastAtan2(2 * (w * z + x * y), 1 - 2 * (y * y + z * z))));
+      } // End of 'toEuler' function
+
+      /* Rotation around axis creation function.
+       *
+       * Arguments:
+       *   vec axis -- unit rotation axis
+       *   Type angle -- rotation angle in radians
+       *
+       * Returns:
+       *   Unit quaternion of rotation.
+       */
+      static constexpr quater<Type> fromAxisAngle(const vec<Type> &axis, const Type &angle)
+      {
+        Real s = 0, c = 0;
+
+        fastSinCos(static_cast<Real>(angle) / 2, s, c);
+        return quater<Type>(Type(c), axis * Type(s));
+      } // End of 'fromAxisAngle' function
+
+      /* Spherical linear interpolation function.
+       * Shortest arc between unit quaternions is interpolated with constant angular speed.
+       *
+       * Arguments:
+       *   quater q1, q2 -- unit quaternions for t = 0 and t = 1
+       *   Type t -- interpolation parameter in [0, 1]
+       *
+       * Returns:
+       *   Unit quaternion between q1 and q2.
+       */
+      static constexpr quater<Type> slerp(const quater<Type> &q1, const quater<Type> &q2, const Type &t)
+      {
+        Real
+          cosAngle = static_cast<Real>(q1 & q2),
+          k = static_cast<Real>(t),
+          k1 = 1 - k,
+          k2 = k;
+
+        // q and -q are same rotation, shortest arc is between q1 and closest of them
+        if (cosAngle < 0)
+        {
+          cosAngle = -cosAngle;
+          k2 = -k2;
+        }
+        // Sine of small angle loses precision, linear interpolation is close enough
+        if (cosAngle < Real(0.9995))
+        {
+          Real
+            angle = fastAcos(cosAngle),
+            inverseSin = 1 / fastSqrt(1 - cosAngle * cosAngle);
+
+          k1 = fastSin(k1 * angle) * inverseSin;
+          k2 = fastSin(k2 * angle) * inverseSin;
+        }
+        quater<Type> r = q1 * Type(k1);
+
+        r += q2 * Type(k2);
+        return r.normalize();
+      } // End of 'slerp' function
+
+    private:
+      /* Multiply by quaternion in place function.
+       * Arguments are copies, so quaternion can be multiplied by itself.
+       *
+       * Arguments:
+       *   Type b0, b1, b2, b3 -- quaternion coordinates to multiply with
+       *
+       * Returns:
+       *   Result of multiplication.
+       */
+      constexpr quater<Type> & multiply(Type b0, Type b1, Type b2, Type b3)
+      {
+        Type
+          a0 = a,
+          a1 = vector[0],
+          a2 = vector[1],
+          a3 = vector[2];
+
+        a = a0 * b0 - a1 * b1 - a2 * b2 - a3 * b3;
+        vector[0] = a0 * b1 + a1 * b0 + a2 * b3 - a3 * b2;
+        vector[1] = a0 * b2 - a1 * b3 + a2 * b0 + a3 * b1;
+        vector[2] = a0 * b3 + a1 * b2 - a2 * b1 + a3 * b0;
+        return *this;
+      } // End of 'multiply' function
     }; // End of 'quater' class
   }// end of 'math' namespace
 } // end of 'mthl' namespace
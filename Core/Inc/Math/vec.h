@@ -4,7 +4,7 @@
  *               Math vector
  * Author      : Tarasov Denis
  * Create date : 03.03.2020
- * Last change : 31.03.2020
+ * Last change : 18.10.2026
  ******************************/
 
 #ifndef __VEC_H_
@@ -15,6 +15,8 @@
 #include <ctype.h>
 #include <stdint.h>
 
+#include "fastmath.h"
+
 /* Mithril namespace */
 namespace mthl
 {
@@ -34,7 +36,7 @@ namespace mthl
        * Arguments:
        *   Type a, b, c -- vector coordinates
        */
-      vec(const Type &a, const Type &b, const Type &c) : x(a), y(b), z(c)
+      constexpr vec(const Type &a, const Type &b, const Type &c) : x(a), y(b), z(c)
       {
 
       } // End of 'vec' constructor
@@ -43,7 +45,7 @@ namespace mthl
        * Arguments:
        *   Type a, b -- vector coordinates
        */
-      vec(const Type &a, const Type &b) : x(a), y(b), z(b)
+      constexpr vec(const Type &a, const Type &b) : x(a), y(b), z(b)
       {
 
       } // End of 'vec' constructor
@@ -52,7 +54,7 @@ namespace mthl
        * Arguments:
        *    Type a -- vector coordinates
        */
-      explicit vec(const Type & a = 0) : x(a), y(a), z(a)
+      constexpr explicit vec(const Type & a = 0) : x(a), y(a), z(a)
       {
 
       } // End of 'vec' constructor
@@ -61,7 +63,7 @@ namespace mthl
        * Arguments:
        *   vec v -- vector to copy
        */
-      vec(const vec<Type> &v) : x(v.x), y(v.y), z(v.z)
+      constexpr vec(const vec<Type> &v) : x(v.x), y(v.y), z(v.z)
       {
 
       } // End of 'vec' constructor
@@ -72,14 +74,14 @@ namespace mthl
        * Returns:
        *   Vector coordinate with given number.
        */
-      Type operator[](int32_t i) const
+      constexpr Type operator[](int32_t i) const
       {
-        if (i < 0)
-          i = 0;
-        else if (i >= 3)
-          i = 2;
+        if (i <= 0)
+          return x;
+        else if (i == 1)
+          return y;
 
-        return *(&this->x + i);
+        return z;
       } // End of 'operator[]' function
 
       /* operator[] overload function.
@@ -88,7 +90,7 @@ namespace mthl
        * Returns:
        *   Vector coordinate with given number.
        */
-      Type & operator[](int32_t i)
+      constexpr Type & operator[](int32_t i)
       {
         return getField(i);
       } // End of 'operator[]' function
@@ -99,9 +101,9 @@ namespace mthl
        * Returns:
        *   Vector length.
        */
-      Type operator!() const
+      constexpr Type operator!() const
       {
-        return sqrt(x * x + y * y + z * z);
+        return fastSqrt(x * x + y * y + z * z);
       } // End of 'operator!' function
 
       /* operator& overload function.
@@ -111,7 +113,7 @@ namespace mthl
        * Returns:
        *   Dot production of two vectors.
        */
-      Type operator&(const vec<Type> & v) const
+      constexpr Type operator&(const vec<Type> & v) const
       {
         return (x * v.x + y * v.y + z * v.z);
       } // End of 'operator&' function
@@ -123,7 +125,7 @@ namespace mthl
        * Returns:
        *   Cross production of two vectors.
        */
-      vec<Type> operator%(const vec<Type> & v) const
+      constexpr vec<Type> operator%(const vec<Type> & v) const
       {
         return vec<Type>(y * v.z - z * v.y, -(x * v.z - z * v.x), x * v.y - y * v.x);
       } // End of 'operator%' function
@@ -135,7 +137,7 @@ namespace mthl
        * Returns:
        *   Component production of two vectors.
        */
-      vec<Type> operator*(const vec<Type> &v) const
+      constexpr vec<Type> operator*(const vec<Type> &v) const
       {
         return vec<Type>(x * v.x, y * v.y, z * v.z);
       } // End of 'operator *' function
@@ -147,7 +149,7 @@ namespace mthl
        * Returns:
        *   Production of vector and number.
        */
-      vec<Type> operator*(const Type &c) const
+      constexpr vec<Type> operator*(const Type &c) const
       {
         return vec<Type>(x * c, y * c, z * c);
       } // End of 'operator*' function
@@ -159,7 +161,7 @@ namespace mthl
        * Returns:
        *   Sum of vectors
        */
-      vec<Type> operator+(const vec<Type> & v) const
+      constexpr vec<Type> operator+(const vec<Type> & v) const
       {
         return vec<Type>(x + v.x, y + v.y, z + v.z);
       } // End of 'operator+' function
@@ -171,7 +173,7 @@ namespace mthl
        * Returns:
        *   Divided vector
        */
-      vec<Type> operator/(const Type &c) const
+      constexpr vec<Type> operator/(const Type &c) const
       {
         if (c == 0)
           return vec<Type>();
@@ -185,7 +187,7 @@ namespace mthl
        * Returns:
        *   Result of substraction
        */
-      vec<Type> operator-(const vec<Type> &v) const
+      constexpr vec<Type> operator-(const vec<Type> &v) const
       {
         return vec<Type>(x - v.x, y - v.y, z - v.z);
       } // End of 'operator-' function
@@ -196,7 +198,7 @@ namespace mthl
        * Returns:
        *   Inverse vector
        */
-      vec<Type> operator-() const
+      constexpr vec<Type> operator-() const
       {
         return vec<Type>(-x, -y, -z);
       } // End of 'operator-' function
@@ -208,7 +210,7 @@ namespace mthl
        * Returns:
        *   Result of multiplication
        */
-      vec<Type> & operator*=(const Type &c)
+      constexpr vec<Type> & operator*=(const Type &c)
       {
         x *= c;
         y *= c;
@@ -224,7 +226,7 @@ namespace mthl
        * Returns:
        *   Result of sum
        */
-      vec<Type> & operator+=(const vec<Type> &v)
+      constexpr vec<Type> & operator+=(const vec<Type> &v)
       {
         x += v.x;
         y += v.y;
@@ -240,7 +242,7 @@ namespace mthl
        * Returns:
        *   Result of substraction
        */
-      vec<Type> & operator-=(const vec<Type> &v)
+      constexpr vec<Type> & operator-=(const vec<Type> &v)
       {
         x -= v.x;
         y -= v.y;
@@ -256,7 +258,7 @@ namespace mthl
        * Returns:
        *   Result of division
        */
-      vec<Type> & operator/=(const Type &c)
+      constexpr vec<Type> & operator/=(const Type &c)
       {
         x /= c;
         y /= c;
@@ -272,7 +274,7 @@ namespace mthl
        * Returns:
        *   Vector coordinate with given number
        */
-      Type & getField(const int32_t i)
+      constexpr Type & getField(const int32_t i)
       {
         if (i <= 0)
           return x;
@@ -288,7 +290,7 @@ namespace mthl
        * Returns:
        *   Normalized vector
        */
-      vec<Type> normalize() const
+      constexpr vec<Type> normalize() const
       {
         return *this / !(*this);
       } // End of 'Normalize' function
@@ -299,7 +301,7 @@ namespace mthl
        * Returns:
        *   Vector squared length.
        */
-      Type lengthSquared() const
+      constexpr Type lengthSquared() const
       {
         return x * x + y * y + z * z;
       } // End of 'LengthSquared' function
@@ -311,7 +313,7 @@ namespace mthl
        * Returns:
        *   Distance between points.
        */
-      Type Distance(const vec<Type> & v) const
+      constexpr Type Distance(const vec<Type> & v) const
       {
         return !(*this - v);
       } // End of 'Distance' function
@@ -324,8 +326,8 @@ namespace mthl
        */
       static vec<Type> randomVector()
       {
-        return vec<Type>(2.0 * rand() / RAND_MAX - 1, 2.0 * rand() / RAND_MAX - 1,
-            2.0 * rand() / RAND_MAX - 1);
+        return vec<Type>((Type)2 * rand() / RAND_MAX - 1, (Type)2 * rand() / RAND_MAX - 1,
+            (Type)2 * rand() / RAND_MAX - 1);
       } // End of 'RandomVector' function
 
       /* Vector with zero fields creation function.
@@ -334,7 +336,7 @@ namespace mthl
        * Returns:
        *   Vector with zero coordinates.
        */
-      static vec<Type> zero()
+      static constexpr vec<Type> zero()
       {
         return vec<Type>();
       } // End of 'Zero' function
@@ -346,14 +348,14 @@ namespace mthl
        * Returns:
        *   Angle between vectors
        */
-      static float getAngleBetween(const vec<Type> &v1, const vec<Type> &v2)
+      static constexpr float getAngleBetween(const vec<Type> &v1, const vec<Type> &v2)
       {
         Type l1 = !v1, l2 = !v2;
 
         if (l1 == 0 || l2 == 0)
           return 0;
 
-        return acosf(v1 & v2 / (l1 * l2));
+        return fastAcos(v1 & v2 / (l1 * l2));
       } // End of 'getAngleBetween' function
 
     }; // End of 'vec' class
@@ -0,0 +1,48 @@
+/******************************
+ * File name   : Power.h
+ * Purpose     : Mithrill project.
+ *               Tickless low power idle
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __POWER_H_
+#define __POWER_H_
+
+#include "stm32f4xx_hal.h"
+
+/* Mithril namespace */
+namespace mthl
+{
+  namespace power
+  {
+    /* Sleep until time passes or any interrupt comes function.
+     * SysTick is reprogrammed to fire only once at wake up time, HAL tick
+     * counter is corrected after wake up. CPU core is stopped with WFI,
+     * all peripherals keep working and wake it by their interrupts.
+     * Must be called with interrupts disabled (PRIMASK set), so interrupt which
+     * comes after the check of pending work still wakes CPU. It is processed
+     * when interrupts are enabled again.
+     *
+     * Arguments:
+     *   uint32_t time -- maximal time to sleep (milliseconds)
+     *
+     * Returns:
+     *   None.
+     */
+    void sleep(uint32_t time);
+
+    /* Time spent in sleep getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Time spent in sleep since start (milliseconds).
+     */
+    uint32_t getSleptTime();
+  } // end of 'power' namespace
+} // end of 'mthl' namespace
+
+#endif // __POWER_H_
@@ -0,0 +1,160 @@
+/******************************
+ * File name   : Probe.h
+ * Purpose     : Mithrill project.
+ *               Hot path timing probes
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __PROBE_H_
+#define __PROBE_H_
+
+/* Probes are built only if MTHL_PROBES is defined (Debug configuration and host build).
+ * Otherwise MTHL_PROBE is empty and nothing of this module gets to firmware.
+ *
+ *   void f()
+ *   {
+ *     MTHL_PROBE(SPINE_ANGLE); // time till the end of scope is measured
+ *     ...
+ *   }
+ */
+#ifdef MTHL_PROBES
+
+#include <stdint.h>
+
+#ifdef MTHL_PROBES_CHRONO
+#include <chrono>
+#else
+#include "Timer.h"
+#endif
+
+/* Mithril namespace */
+namespace mthl
+{
+  /* Timing probes namespace.
+   * Ticks are CPU cycles of DWT counter, or nanoseconds of host clock if
+   * MTHL_PROBES_CHRONO is defined. Each probe keeps number of runs, minimal,
+   * maximal and total ticks and histogram of ticks by powers of two.
+   */
+  namespace probe
+  {
+    /* Probe identifier enum class declaration */
+    enum class Id : uint8_t
+    {
+      IMU_UPDATE,    // filtering of new IMU-sensor data
+      COMPLEMENTARY, // complementary filter step
+      ABS_ANGLES,    // IMU-sensor angles getting
+      SPINE_ANGLE,   // spine angle evaluation
+      POSTURE,       // posture evaluation
+      UART_WRITE,    // writing to UART transmit queue
+      COUNT          // number of probes
+    }; // End of 'Id' enum class
+
+    static constexpr const uint32_t HISTOGRAM_SIZE = 32; // Bucket i counts runs of [2^(i-1), 2^i) ticks
+
+    /* Probe statistics structure */
+    struct Stats
+    {
+      uint32_t count;                     // number of runs
+      uint32_t min, max;                  // minimal and maximal ticks of run
+      uint64_t sum;                       // ticks of all runs
+      uint32_t histogram[HISTOGRAM_SIZE]; // number of runs by log2 of ticks
+    }; // End of 'Stats' structure
+
+    /* Current ticks getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Ticks counter, it wraps.
+     */
+    inline uint32_t now()
+    {
+#ifdef MTHL_PROBES_CHRONO
+      return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch()).count());
+#else
+      return timer::getCycles();
+#endif
+    } // End of 'now' function
+
+    /* Add probe run function.
+     * Can be called from interrupts.
+     *
+     * Arguments:
+     *   Id id -- probe
+     *   uint32_t ticks -- duration of run
+     *
+     * Returns:
+     *   None.
+     */
+    void record(Id id, uint32_t ticks);
+
+    /* Probe statistics getter.
+     *
+     * Arguments:
+     *   Id id -- probe
+     *
+     * Returns:
+     *   Statistics since start or previous reset.
+     */
+    Stats getStats(Id id);
+
+    /* Probe name getter.
+     *
+     * Arguments:
+     *   Id id -- probe
+     *
+     * Returns:
+     *   Name of probe.
+     */
+    const char * getName(Id id);
+
+    /* Clear statistics of all probes function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void reset();
+
+    /* Scoped probe class declaration.
+     * Time from construction to destruction is recorded.
+     */
+    class Scope final
+    {
+    public:
+      explicit Scope(Id id) : id(id), start(now())
+      {
+      }
+
+      Scope(const Scope &) = delete;
+      Scope & operator=(const Scope &) = delete;
+
+      ~Scope()
+      {
+        record(id, now() - start);
+      }
+
+    private:
+      Id id;          // probe
+      uint32_t start; // ticks at construction
+    }; // End of 'Scope' class
+  } // end of 'probe' namespace
+} // end of 'mthl' namespace
+
+#define MTHL_PROBE_NAME(line) mthlProbe##line
+#define MTHL_PROBE_AT(id, line) mthl::probe::Scope MTHL_PROBE_NAME(line)(mthl::probe::Id::id)
+#define MTHL_PROBE(id) MTHL_PROBE_AT(id, __LINE__)
+
+#else
+
+#define MTHL_PROBE(id)
+
+#endif // MTHL_PROBES
+
+#endif // __PROBE_H_
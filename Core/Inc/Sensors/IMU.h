@@ -5,7 +5,7 @@
  * Author      : Tarasov Denis
  *               Filippov Denis
  * Create date : 02.03.2020
- * Last change : 26.05.2020
+ * Last change : 18.10.2026
  ******************************/
 
 #ifndef __IMU_H_
@@ -14,6 +14,7 @@
 #include <stdexcept>
 
 #include "Math/quater.h"
+#include "Filters/Filters.h"
 
 /* Mithril namespace */
 namespace mthl
@@ -24,6 +25,24 @@ namespace mthl
   class IMU
   {
   public:
+    /* Motion sample structure.
+     * One coherent reading of all motion channels taken at the same moment.
+     */
+    struct Sample
+    {
+      math::quater<float> accel, // accelerometer data
+                          gyro;  // calibrated gyroscope data
+      float temp = 0;            // temperature in Celsius degrees
+      uint32_t time = 0;         // time of reading (timer cycles)
+    }; // End of 'Sample' structure
+
+    /* Calibration data structure */
+    struct Calibration
+    {
+      math::quater<float> gyro,   // gyroscope bias
+                          angles; // reference angles
+    }; // End of 'Calibration' structure
+
     IMU() = default;
     virtual ~IMU() = default;
 
@@ -47,6 +66,16 @@ namespace mthl
      */
     virtual void readGyro(math::quater<float> &v)  = 0;
 
+    /* Read accelerometer, temperature and gyroscope data at once
+     *
+     * Arguments:
+     *   Sample &s -- sample to store data
+     *
+     * Returns:
+     *   None.
+     */
+    virtual void readMotion(Sample &s) = 0;
+
     /* Read data from accelerometer
      *
      * Arguments:
@@ -63,9 +92,81 @@ namespace mthl
      *   int32_t iterations -- number of iterations to calibrate
      *
      * Returns:
+     *   true if device was calibrated.
+     */
+    virtual bool calibrate(int32_t iterations = 100) = 0;
+
+    /* Sensor identity getter.
+     * Identity is the same after reset while sensor is connected to the same place.
+     *
+     * Arguments:
      *   None.
+     *
+     * Returns:
+     *   Sensor identity.
      */
-    virtual void calibrate(int32_t iterations = 100) = 0;
+    virtual uint32_t getId() = 0;
+
+    /* Calibration data getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Calibration data evaluated by 'calibrate'.
+     */
+    virtual Calibration getCalibration() = 0;
+
+    /* Calibration data setter.
+     * Used instead of 'calibrate' with previously stored data.
+     *
+     * Arguments:
+     *   const Calibration &calibration -- calibration data
+     *
+     * Returns:
+     *   None.
+     */
+    virtual void setCalibration(const Calibration &calibration) = 0;
+
+    /* Set orientation filter
+     *
+     * Arguments:
+     *   filters::Type type -- filter to use for angles evaluation
+     *
+     * Returns:
+     *   None.
+     */
+    virtual void setFilter(filters::Type type) = 0;
+
+    /* Filter data read since previous update function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    virtual void update() = 0;
+
+    /* Set complementary filter time constant function.
+     *
+     * Arguments:
+     *   float timeConst -- time constant (seconds)
+     *
+     * Returns:
+     *   None.
+     */
+    virtual void setFilterTimeConst(float timeConst) = 0;
+
+    /* Set sampling period function.
+     *
+     * Arguments:
+     *   uint32_t period -- sampling period (milliseconds)
+     *
+     * Returns:
+     *   true if period was set.
+     */
+    virtual bool setSamplePeriod(uint32_t period) = 0;
 
     /* Evaluate angles of deflection.
      *
@@ -78,6 +179,7 @@ namespace mthl
     virtual math::quater<float> getAnglesOfDefl() = 0;
 
     /* Evaluate absolute angles.
+     * Angles are changed only by 'update'.
      *
      * Arguments:
      *   None.
@@ -87,6 +189,17 @@ namespace mthl
      */
     virtual math::quater<float> getAbsAngles() = 0;
 
+    /* Last filtered sample getter.
+     * Sample is changed only by 'update'.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Last sample passed through orientation filter.
+     */
+    virtual Sample getLastSample() = 0;
+
   }; // End of 'IMU' class
 } // end of 'mthl' namespace
 
@@ -5,7 +5,7 @@
  * Author      : Tarasov Denis
  *               Filippov Denis
  * Create date : 02.03.2020
- * Last change : 26.05.2020
+ * Last change : 18.10.2026
  ******************************/
 
 #ifndef __MCU6050_H_
@@ -19,12 +19,15 @@
 namespace mthl
 {
   /* MCU6050 class declaration
-   * Class for MCU6050 device
+   * Class for MCU6050 device.
+   * Filtering and getters are final, so they are called directly through MCU6050
+   * pointers, only reading from device can be overridden.
    */
   class MCU6050 : public IMU
   {
   public:
     /* MCU6050 constructor function
+     * Device is not calibrated, 'calibrate' or 'setCalibration' must be called.
      *
      * Arguments:
      *   I2C_HandleTypeDef *handle -- I2C handler
@@ -52,15 +55,187 @@ namespace mthl
      */
     void readGyro(math::quater<float> &v) override;
 
+    /* Read accelerometer, temperature and gyroscope data at once
+     *
+     * Arguments:
+     *   Sample &s -- sample to store data
+     *
+     * Returns:
+     *   None.
+     */
+    void readMotion(Sample &s) override;
+
+    /* Start reading of accelerometer, temperature and gyroscope data with DMA.
+     * Data is taken by 'finishMotionRead' function after transfer completion.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Status of transfer start.
+     */
+    HAL_StatusTypeDef startMotionRead();
+
+    /* Finish reading of data started by 'startMotionRead' function.
+     * Sample will be used by next angles evaluation instead of blocking reading.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void finishMotionRead();
+
+    /* Enable data ready interrupt function.
+     * Device sets INT pin with DATA_READY_RATE rate when new sample is measured.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   true if interrupt was enabled, false otherwise.
+     */
+    bool enableDataReadyInt();
+
+    /* Enable FIFO mode function.
+     * Accelerometer and gyroscope data are stored in device FIFO with FIFO_SAMPLE_RATE rate
+     * and angles evaluation processes all stored samples.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   true if FIFO was enabled, false otherwise.
+     */
+    bool enableFifo();
+
+    /* Disable FIFO mode function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void disableFifo();
+
+    /* Process all samples stored in FIFO function.
+     * All stored samples are read in one transaction and passed through the filter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Number of processed samples.
+     */
+    uint32_t drainFifo();
+
+    /* Number of FIFO overflows getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Number of FIFO overflows.
+     */
+    uint32_t getFifoOverflowsCount() const;
+
+    /* I2C handler getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   I2C handler of device.
+     */
+    I2C_HandleTypeDef * getHandle() const;
+
     /* Calibrate device
      *
      * Arguments:
      *   int32_t iterations -- number of iterations to calibrate
      *
      * Returns:
+     *   true if device was calibrated, false if it is offline.
+     */
+    bool calibrate(int32_t iterations) override;
+
+    /* Sensor identity getter.
+     * Identity is made of I2C bus and device address.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Sensor identity.
+     */
+    uint32_t getId() override;
+
+    /* Calibration data getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Calibration data evaluated by 'calibrate'.
+     */
+    Calibration getCalibration() final;
+
+    /* Calibration data setter.
+     * Used instead of 'calibrate' with previously stored data.
+     *
+     * Arguments:
+     *   const Calibration &calibration -- calibration data
+     *
+     * Returns:
+     *   None.
+     */
+    void setCalibration(const Calibration &calibration) final;
+
+    /* Set orientation filter
+     *
+     * Arguments:
+     *   filters::Type type -- filter to use for angles evaluation
+     *
+     * Returns:
+     *   None.
+     */
+    void setFilter(filters::Type type) final;
+
+    /* Filter data read since previous update function.
+     * Data is taken from FIFO if it is enabled, otherwise sample read
+     * with DMA is used. Nothing is done if there is no new data.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
      *   None.
      */
-    void calibrate(int32_t iterations) override;
+    void update() final;
+
+    /* Set complementary filter time constant function.
+     *
+     * Arguments:
+     *   float timeConst -- time constant (seconds)
+     *
+     * Returns:
+     *   None.
+     */
+    void setFilterTimeConst(float timeConst) final;
+
+    /* Set sampling period function.
+     * Period is set by device rate divider of 1KHz data rate, so data ready
+     * interrupt must be enabled. Sampling period of FIFO mode is not changed.
+     *
+     * Arguments:
+     *   uint32_t period -- sampling period (milliseconds), from 1 to 256
+     *
+     * Returns:
+     *   true if period was set.
+     */
+    bool setSamplePeriod(uint32_t period) override;
 
     /* Evaluate angles of deflection.
      *
@@ -70,9 +245,10 @@ namespace mthl
      * Returns:
      *   Filtered angles
      */
-    math::quater<float> getAnglesOfDefl() override;
+    math::quater<float> getAnglesOfDefl() final;
 
     /* Evaluate absolute angles.
+     * Angles are changed only by 'update'.
      *
      * Arguments:
      *   None.
@@ -80,10 +256,55 @@ namespace mthl
      * Returns:
      *   Filtered angles
      */
-    math::quater<float> getAbsAngles() override;
+    math::quater<float> getAbsAngles() final;
+
+    /* Last filtered sample getter.
+     * Sample is changed only by 'update'.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Last sample passed through orientation filter.
+     */
+    Sample getLastSample() final;
 
     static constexpr const uint8_t MPU6050_ADDR_1 = 0xD0,  // Device register on 5v
                       MPU6050_ADDR_2 = 0xD2;  // Device register on 3.3v
+
+    /* Size of accelerometer, temperature and gyroscope data block */
+    static constexpr const uint16_t MOTION_DATA_SIZE = 14;
+
+  protected:
+    /* MCU6050 constructor of sensor without device on bus.
+     * Raw data comes to derived class from other source (recorded trace)
+     * and is passed to 'putMotion' function.
+     */
+    MCU6050();
+
+    /* Convert raw accelerometer, temperature and gyroscope data to sample
+     *
+     * Arguments:
+     *   const uint8_t *buffer -- raw data
+     *   Sample &s -- sample to store data
+     *
+     * Returns:
+     *   None.
+     */
+    void decodeMotion(const uint8_t *buffer, Sample &s) const;
+
+    /* Put raw motion data read from device function.
+     * Sample will be used by next angles evaluation, as one read by 'startMotionRead'.
+     *
+     * Arguments:
+     *   const uint8_t *buffer -- raw accelerometer, temperature and gyroscope data
+     *   uint32_t time -- time of reading (timer cycles)
+     *
+     * Returns:
+     *   None.
+     */
+    void putMotion(const uint8_t *buffer, uint32_t time);
+
   private:
     I2C_HandleTypeDef *i2c_handle;
     uint8_t addres;
@@ -95,17 +316,120 @@ namespace mthl
                       TEMP_OUT_H_REG = 0x41,   // Temperature register for getting data
                       PWR_MGMT_1_REG = 0x6B,   // Wake up register
                       WHO_AM_I_REG = 0x75,     // Identifier register
-                      SMPLRT_DIV_REG = 0x19;   // Data rate setup register
+                      SMPLRT_DIV_REG = 0x19,   // Data rate setup register
+                      CONFIG_REG = 0x1A,       // Low pass filter setup register
+                      FIFO_EN_REG = 0x23,      // FIFO data selection register
+                      INT_STATUS_REG = 0x3A,   // Interrupts status register
+                      INT_PIN_CFG_REG = 0x37,  // INT pin configuration register
+                      INT_ENABLE_REG = 0x38,   // Interrupts enable register
+                      USER_CTRL_REG = 0x6A,    // FIFO enable and reset register
+                      FIFO_COUNTH_REG = 0x72,  // Number of bytes in FIFO register
+                      FIFO_R_W_REG = 0x74;     // FIFO data register
+
+    /* MCU6050 register bits */
+    static constexpr const uint8_t FIFO_EN_ACCEL_GYRO = 0x78, // Accelerometer and gyroscope data to FIFO
+                      USER_CTRL_FIFO_EN = 0x40,              // FIFO enable bit
+                      USER_CTRL_FIFO_RESET = 0x04,           // FIFO reset bit
+                      INT_STATUS_FIFO_OFLOW = 0x10,          // FIFO overflow bit
+                      INT_ENABLE_DATA_RDY = 0x01,            // Data ready interrupt enable bit
+                      INT_PIN_CFG_PULSE = 0x00,              // Active high push-pull 50us pulse on INT pin
+                      CONFIG_DLPF_44HZ = 0x03,               // Low pass filter 44Hz, gyroscope output rate 1KHz
+                      FIFO_RATE_DIV = 9,                     // FIFO samples rate 1KHz / (1 + 9) = 100Hz
+                      DATA_READY_RATE_DIV = 99;              // Data ready rate 1KHz / (1 + 99) = 10Hz
 
     static constexpr const uint8_t SIGNATURE = 0x68; // Device signature
 
     /* Data scalers */
     static constexpr const float ACC_SCALE = 16384.0, // Accelerometer scale +-2g
-                      GYRO_SCALE = 131.0;             // Gyroscope scale +-250 d/s
+                      GYRO_SCALE = 131.0,             // Gyroscope scale +-250 d/s
+                      TEMP_SCALE = 340.0,             // Temperature scale
+                      TEMP_OFFSET = 36.53;            // Temperature offset
+
+    static constexpr const uint16_t
+                      FIFO_FRAME_SIZE = 12, // Size of accelerometer and gyroscope sample in FIFO
+                      FIFO_SIZE = 1024;     // Size of device FIFO
+
+    /* Time between samples in FIFO (seconds) */
+    static constexpr const float FIFO_SAMPLE_PERIOD = (1 + FIFO_RATE_DIV) / 1000.0;
+
+    /* Default complementary filter time constant (seconds) */
+    static constexpr const float FILTER_TIME_CONST = 0.16;
+
+    /* Quaternion filters gains */
+    static constexpr const float MADGWICK_BETA = 0.1, // Madgwick gradient descent step
+                      MAHONY_KP = 1.0,                // Mahony proportional gain
+                      MAHONY_KI = 0.01;               // Mahony integral gain
+
+    /* Maximal time between samples for the filter (seconds).
+     * Gyroscope data is not integrated over longer gaps.
+     */
+    static constexpr const float MAX_SAMPLE_PERIOD = 0.5;
+
+    /* Buffer for FIFO reading. It is shared, because FIFOs are drained one by one */
+    static uint8_t fifoBuffer[FIFO_SIZE];
 
     math::quater<float> calibratedGyro, // Calibrated gyroscope quaternion
                       angles,           // Filtered angles
                       calibratedAngles; // Calibrated angles
+
+    filters::Type filterType = filters::Type::COMPLEMENTARY; // Orientation filter
+    float filterTimeConst = FILTER_TIME_CONST; // Complementary filter time constant (seconds)
+    math::quater<float> orientation;    // Orientation quaternion for quaternion filters
+    math::vec<float> mahonyIntegral;    // Integral of Mahony filter error
+    bool isOrientationSet = false;      // Is orientation initialized
+
+    uint8_t motionBuffer[MOTION_DATA_SIZE]; // Buffer for DMA reading
+    uint32_t motionTime = 0;                // Time of DMA reading start
+    Sample pendingSample;                   // Sample read with DMA and not processed yet
+    bool isSamplePending = false;           // Is there sample read with DMA
+    uint32_t prevSampleTime = 0;            // Time of previous filtered sample
+    Sample lastSample;                      // Last filtered sample
+    bool isFifoOn = false;                  // Is FIFO mode enabled
+    bool isOnline = false;                  // Is device signature correct
+    uint32_t fifoOverflowsCount = 0;        // Number of FIFO overflows
+
+    /* Convert FIFO frame to sample
+     *
+     * Arguments:
+     *   const uint8_t *buffer -- FIFO frame
+     *   Sample &s -- sample to store data
+     *
+     * Returns:
+     *   None.
+     */
+    void decodeFifoFrame(const uint8_t *buffer, Sample &s) const;
+
+    /* Pass sample through orientation filter function
+     *
+     * Arguments:
+     *   const Sample &s -- sample to filter
+     *   float dtime -- time passed since previous sample
+     *
+     * Returns:
+     *   None.
+     */
+    void filterSample(const Sample &s, float dtime);
+
+    /* Evaluate time passed since previous filtered sample function
+     *
+     * Arguments:
+     *   uint32_t time -- time of new sample
+     *
+     * Returns:
+     *   Time passed in seconds.
+     */
+    float getSamplePeriod(uint32_t time);
+
+    /* Reset device FIFO function
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Status of writing to device.
+     */
+    HAL_StatusTypeDef resetFifo();
+
     /* Read raw data from gyroscope
      *
      * Arguments:
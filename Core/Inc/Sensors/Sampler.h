@@ -0,0 +1,272 @@
+/******************************
+ * File name   : Sampler.h
+ * Purpose     : Mithrill project.
+ *               Non-blocking DMA sampling engine for MCU6050 sensors
+ * Author      : Tarasov Denis
+ *               Filippov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __SAMPLER_H_
+#define __SAMPLER_H_
+
+#include <array>
+
+#include "stm32f4xx_hal.h"
+
+#include "MCU6050.h"
+
+/* Mithril namespace */
+namespace mthl
+{
+  /* Sampler class declaration.
+   * Reads all sensors with DMA. Sensors on one bus are read one after another.
+   * Interrupts only mark sensors data ready and finished transfers, all transfers
+   * are started from thread context by 'start' and 'service', because HAL memory
+   * reading sends register address with blocking waits on tick timeouts. So buses
+   * overlap only while DMA receives data. Finished sample set is handed to sensors by 'dispatch'.
+   * If sensors have data ready pins, new set is read when all of them report
+   * fresh data, otherwise it is read right after previous set is dispatched.
+   * Pin which is silent for DATA_READY_TIMEOUT is not waited for anymore, so broken
+   * interrupt line of one sensor does not stop sampling.
+   */
+  class Sampler final
+  {
+  public:
+    static constexpr const std::size_t MAX_BUSES = 2,  // Maximal number of I2C buses
+                      MAX_BUS_SENSORS = 4;             // Maximal number of sensors on one bus
+    static constexpr const uint32_t DATA_READY_TIMEOUT = 500; // Maximal wait for data ready pins (milliseconds)
+
+    /* Add sensor to sampling function.
+     *
+     * Arguments:
+     *   MCU6050 *sensor -- sensor to read
+     *   uint16_t dataReadyPin -- EXTI pin of sensor data ready interrupt (0 if there is no pin)
+     *
+     * Returns:
+     *   true if sensor was added, false if there is no place for it.
+     */
+    bool addSensor(MCU6050 *sensor, uint16_t dataReadyPin = 0);
+
+    /* Start reading of new sample set function.
+     * Called from thread context only, it also starts transfers requested by interrupts.
+     * Reading is started only if there are sensors, previous set is dispatched,
+     * sampler is not paused and all data ready pins were reported since previous set.
+     * Pins which are not reported for DATA_READY_TIMEOUT since first check are dropped.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   true if reading was started, false otherwise.
+     */
+    bool start();
+
+    /* Start transfers requested by interrupts function.
+     * Called from thread context only: next sensors on buses are read after
+     * transfer completion interrupts.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void service();
+
+    /* Check if sampler has work for thread context function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   true if transfer waits for start or new set can be started.
+     */
+    bool isPending() const;
+
+    /* Pause or resume starting of new sample sets function.
+     *
+     * Arguments:
+     *   bool isOn -- true to pause, false to resume
+     *
+     * Returns:
+     *   None.
+     */
+    void setPaused(bool isOn);
+
+    /* Check if reading of sample set is in progress function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   true if any bus is still busy.
+     */
+    bool isBusy() const;
+
+    /* Check if finished sample set waits for dispatch function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   true if there is finished set.
+     */
+    bool isReady() const;
+
+    /* Hand finished sample set to sensors function.
+     * Each sensor will use its sample for next angles evaluation.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   true if sample set was handed, false if there is no finished set.
+     */
+    bool dispatch();
+
+    /* Drop finished sample set function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void drop();
+
+    /* Data ready interrupt processing function.
+     * Called from EXTI interrupt context, new set is started by 'start'.
+     *
+     * Arguments:
+     *   uint16_t pin -- EXTI pin of interrupt
+     *
+     * Returns:
+     *   None.
+     */
+    void onDataReady(uint16_t pin);
+
+    /* Transfer completion processing function.
+     * Called from I2C interrupt context, next transfer is started by 'service'.
+     *
+     * Arguments:
+     *   I2C_HandleTypeDef *hi2c -- I2C handler of finished transfer
+     *
+     * Returns:
+     *   None.
+     */
+    void onReadComplete(I2C_HandleTypeDef *hi2c);
+
+    /* Transfer error processing function.
+     * Called from I2C interrupt context.
+     *
+     * Arguments:
+     *   I2C_HandleTypeDef *hi2c -- I2C handler of failed transfer
+     *
+     * Returns:
+     *   None.
+     */
+    void onReadError(I2C_HandleTypeDef *hi2c);
+
+    /* Number of failed transfers getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Number of failed transfers.
+     */
+    uint32_t getErrorsCount() const;
+
+    /* Number of dropped data ready pins getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Number of pins which were silent for DATA_READY_TIMEOUT.
+     */
+    uint32_t getSilentPinsCount() const;
+
+  private:
+    /* I2C bus structure */
+    struct Bus
+    {
+      I2C_HandleTypeDef *handle = nullptr;                 // I2C handler
+      std::array<MCU6050 *, MAX_BUS_SENSORS> sensors{};    // sensors on this bus
+      std::array<bool, MAX_BUS_SENSORS> isRead{};          // is sensor data read in current set
+      std::size_t count = 0;                               // number of sensors on this bus
+      volatile std::size_t current = 0;                    // sensor which is read now
+    }; // End of 'Bus' structure
+
+    std::array<Bus, MAX_BUSES> buses{}; // used I2C buses
+    std::size_t busesCount = 0;         // number of used I2C buses
+    volatile std::size_t busyBuses = 0; // number of buses which are still read
+    volatile uint32_t pendingBuses = 0; // bits of buses which next transfer waits for start
+    volatile bool isSetReady = false;   // is there finished sample set
+    volatile bool isPaused = false;     // is starting of new sets paused
+    uint16_t triggerPins = 0;           // data ready pins of all sensors
+    volatile uint16_t readyPins = 0;    // data ready pins reported since previous set
+    bool isWaiting = false;             // is set waiting for data ready pins
+    uint32_t waitStartTime = 0;         // time of first check of waiting set (milliseconds)
+    volatile uint32_t errorsCount = 0;  // number of failed transfers
+    uint32_t silentPinsCount = 0;       // number of dropped data ready pins
+
+    /* Find bus by I2C handler function.
+     *
+     * Arguments:
+     *   I2C_HandleTypeDef *hi2c -- I2C handler
+     *
+     * Returns:
+     *   Pointer to bus or nullptr if there is no such bus.
+     */
+    Bus * findBus(I2C_HandleTypeDef *hi2c);
+
+    /* Mark new sample set without any checks function.
+     * Called with interrupts disabled, transfers are started by 'service'.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void markSet();
+
+    /* Start reading sensors on bus from current one function.
+     * Sensors which fail to start are skipped.
+     *
+     * Arguments:
+     *   Bus &bus -- bus to read
+     *
+     * Returns:
+     *   None.
+     */
+    void startBus(Bus &bus);
+
+    /* Continue reading sensors on bus after transfer function.
+     * Called from I2C interrupt context.
+     *
+     * Arguments:
+     *   Bus &bus -- bus which transfer is finished
+     *
+     * Returns:
+     *   None.
+     */
+    void continueBus(Bus &bus);
+
+    /* Count finished bus function.
+     * Called with interrupts disabled or from interrupt context.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void finishBus();
+  }; // End of 'Sampler' class
+} // end of 'mthl' namespace
+
+#endif /* __SAMPLER_H_ */
@@ -0,0 +1,50 @@
+/******************************
+ * File name   : SensorSet.h
+ * Purpose     : Mithrill project.
+ *               Compile-time set of IMU-sensors of device
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __SENSOR_SET_H_
+#define __SENSOR_SET_H_
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+#include "MCU6050.h"
+
+/* Mithril namespace */
+namespace mthl
+{
+  static constexpr const std::size_t SENSORS_COUNT = 3; // Number of IMU-sensors along spine (upper first)
+
+  /* Set of IMU-sensors which functions work with.
+   * Sensors are MCU6050 drivers (or derived replayed sensors), so functions which are
+   * final in MCU6050 are called directly and there is no heap indirection.
+   */
+  using SensorSet = std::array<MCU6050 *, SENSORS_COUNT>;
+
+  /* Make set of sensors function.
+   *
+   * Arguments:
+   *   std::array<Sensor, SENSORS_COUNT> &sensors -- sensors objects
+   *
+   * Returns:
+   *   Set of sensors.
+   */
+  template<class Sensor>
+  SensorSet makeSensorSet(std::array<Sensor, SENSORS_COUNT> &sensors)
+  {
+    static_assert(std::is_base_of<MCU6050, Sensor>::value, "Sensors of set must be MCU6050 drivers");
+    SensorSet set{};
+
+    for (std::size_t i = 0; i < SENSORS_COUNT; ++i)
+      set[i] = &sensors[i];
+    return set;
+  } // End of 'makeSensorSet' function
+} // end of 'mthl' namespace
+
+#endif // __SENSOR_SET_H_
@@ -0,0 +1,115 @@
+/******************************
+ * File name   : CalibrationStore.h
+ * Purpose     : Mithril project.
+ *               IMU-sensors calibration storage in flash class declaration
+ * Author      : Filippov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __CALIBRATION_STORE_H_
+#define __CALIBRATION_STORE_H_
+
+#include "stm32f4xx_hal.h"
+
+#include "Sensors/IMU.h"
+
+/* Mithril namespace */
+namespace mthl
+{
+  /* Calibration storage class declaration.
+   * Calibrations of all sensors are kept in one record in flash sector 7, which is
+   * excluded from program memory by linker script. Each save appends new record after
+   * previous ones, sector is erased only when it is full. Last record with correct
+   * magic, version and CRC is loaded, so broken or outdated data causes recalibration.
+   */
+  class CalibrationStore final
+  {
+  public:
+    static constexpr const uint32_t MAX_SENSORS = 4; // Maximal number of stored sensors
+    static constexpr const uint16_t VERSION = 2;     // Record layout version (1 had offline sensors entries)
+
+    /* Load last stored record function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   true if correct record was found.
+     */
+    bool load();
+
+    /* Restore sensor calibration function.
+     *
+     * Arguments:
+     *   IMU &imu -- sensor to restore calibration
+     *
+     * Returns:
+     *   true if record has calibration of this sensor.
+     */
+    bool restore(IMU &imu) const;
+
+    /* Put sensor calibration to record function.
+     * Record is written to flash by 'save'.
+     *
+     * Arguments:
+     *   IMU &imu -- calibrated sensor (sensor which 'calibrate' failed must not be put)
+     *
+     * Returns:
+     *   true if there was place for sensor.
+     */
+    bool put(IMU &imu);
+
+    /* Save record to flash function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   true if record was saved.
+     */
+    bool save();
+
+  private:
+    /* Sensor calibration entry structure */
+    struct Entry
+    {
+      uint32_t id;      // sensor identity
+      float gyro[3];    // gyroscope bias (degrees per second)
+      float angles[3];  // reference angles
+    }; // End of 'Entry' structure
+
+    /* Flash record structure */
+    struct Record
+    {
+      uint32_t magic;               // MAGIC for records
+      uint16_t version;             // record layout version
+      uint16_t count;               // number of entries
+      Entry entries[MAX_SENSORS];   // sensors calibrations
+      uint32_t crc;                 // CRC16 of previous fields
+    }; // End of 'Record' structure
+
+    static_assert(sizeof(Record) % 4 == 0, "Record is programmed by words");
+
+    static constexpr const uint32_t
+      SECTOR = FLASH_SECTOR_7,   // Flash sector of records
+      ADDRESS = 0x08060000,      // Address of sector
+      SIZE = 128 * 1024,         // Size of sector
+      MAGIC = 0x4C41434D;        // Record mark ("MCAL")
+
+    Record record{};       // current record
+    uint32_t nextSlot = 0; // offset of first free place in sector
+
+    /* Evaluate record CRC function.
+     *
+     * Arguments:
+     *   const Record &rec -- record
+     *
+     * Returns:
+     *   CRC of record fields before 'crc'.
+     */
+    static uint32_t evalCrc(const Record &rec);
+  }; // End of 'CalibrationStore' class
+} // end of 'mthl' namespace
+
+#endif // __CALIBRATION_STORE_H_
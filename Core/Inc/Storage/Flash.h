@@ -0,0 +1,61 @@
+/******************************
+ * File name   : Flash.h
+ * Purpose     : Mithril project.
+ *               Internal flash memory access functions
+ * Author      : Filippov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __FLASH_H_
+#define __FLASH_H_
+
+#include "stm32f4xx_hal.h"
+
+/* Mithril namespace */
+namespace mthl
+{
+  /* Internal flash memory functions.
+   * Sectors used for data are excluded from FLASH region of linker script.
+   * Erased flash is read as 0xFF bytes, programming can only clear bits.
+   * CPU stalls while flash is erased or programmed.
+   */
+  namespace flash
+  {
+    /* Erase sector function.
+     * Erasing of 128K sector takes 1-2 seconds.
+     *
+     * Arguments:
+     *   uint32_t sector -- sector number (FLASH_SECTOR_x)
+     *
+     * Returns:
+     *   true if sector was erased.
+     */
+    bool erase(uint32_t sector);
+
+    /* Program words function.
+     *
+     * Arguments:
+     *   uint32_t address -- address to program, it is aligned to 4 bytes
+     *   const void *data -- data to program
+     *   uint32_t size -- data size, it is multiple of 4
+     *
+     * Returns:
+     *   true if data was programmed.
+     */
+    bool program(uint32_t address, const void *data, uint32_t size);
+
+    /* Check if memory is erased function.
+     *
+     * Arguments:
+     *   uint32_t address -- address to check, it is aligned to 4 bytes
+     *   uint32_t size -- size to check, it is multiple of 4
+     *
+     * Returns:
+     *   true if all bytes are 0xFF.
+     */
+    bool isErased(uint32_t address, uint32_t size);
+  } // end of 'flash' namespace
+} // end of 'mthl' namespace
+
+#endif // __FLASH_H_
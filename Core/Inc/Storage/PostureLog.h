@@ -0,0 +1,173 @@
+/******************************
+ * File name   : PostureLog.h
+ * Purpose     : Mithril project.
+ *               Posture history log in flash class declaration
+ * Author      : Filippov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __POSTURE_LOG_H_
+#define __POSTURE_LOG_H_
+
+#include "stm32f4xx_hal.h"
+
+/* Mithril namespace */
+namespace mthl
+{
+  /* Posture log class declaration.
+   * Append-only log of 8 byte entries in flash sectors 5 and 6, which are excluded
+   * from program memory by linker script. Entries are written to active sector one
+   * after another, so appending is programming of two words. When active sector is
+   * nearly full, the other one (with the oldest entries) is erased by 'prepare' ahead of
+   * time, and it becomes active when active one is full. So posture processing does not
+   * wait for erasing, both sectors are worn equally and the last 124K of history is
+   * always kept. Only positions are kept in RAM.
+   * Flash has one bank, so erasing stalls all code and interrupts for 1-2 seconds:
+   * caller of 'prepare' stops transfers which can't wait that long.
+   */
+  class PostureLog final
+  {
+  public:
+    /* Log event type enum class declaration */
+    enum class Event : uint8_t
+    {
+      BOOT = 1,    // device start, data is boot number
+      POSTURE = 2, // posture verdict changed, data is 1 if posture is correct
+      ANGLES = 3   // mean spine angles since previous summary, data is two i16 (0.01 degree)
+    }; // End of 'Event' enum class
+
+    /* Log entry structure */
+    struct Entry
+    {
+      uint32_t header; // time since boot (seconds) in bits 0-23, event type in bits 24-31
+      uint32_t data;   // event data
+    }; // End of 'Entry' structure
+
+    /* Find end of log and mark boot function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void init();
+
+    /* Append event to log function.
+     *
+     * Arguments:
+     *   Event type -- event type
+     *   uint32_t data -- event data
+     *
+     * Returns:
+     *   true if event was written.
+     */
+    bool append(Event type, uint32_t data);
+
+    /* Check if sector for next entries has to be erased function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   true if active sector has less than PREPARE_MARGIN free bytes and other one is not erased.
+     */
+    bool isPrepareNeeded() const;
+
+    /* Erase sector for next entries ahead of time function.
+     * Sector is erased only if 'isPrepareNeeded'. Erasing stalls CPU with all
+     * interrupts for 1-2 seconds.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   true if sector was erased.
+     */
+    bool prepare();
+
+    /* Start reading from the oldest entry function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void rewind();
+
+    /* Read next entry function.
+     *
+     * Arguments:
+     *   Entry &entry -- read entry
+     *
+     * Returns:
+     *   true if entry was read, false at the end of log.
+     */
+    bool read(Entry &entry);
+
+  private:
+    static constexpr const uint32_t
+      SECTORS_COUNT = 2,            // Number of log sectors
+      SECTOR_SIZE = 128 * 1024,     // Size of sector
+      HEADER_SIZE = 8,              // Size of sector header: MAGIC and sequence number
+      PREPARE_MARGIN = 4 * 1024,    // Free space of active sector when next one is erased
+      MAGIC = 0x474F4C4D;           // Sector header mark ("MLOG")
+
+    /* Flash sectors numbers */
+    static constexpr const uint32_t SECTORS[SECTORS_COUNT] = {FLASH_SECTOR_5, FLASH_SECTOR_6};
+    /* Flash sectors addresses */
+    static constexpr const uint32_t ADDRESSES[SECTORS_COUNT] = {0x08020000, 0x08040000};
+
+    uint32_t active = 0;     // index of sector to write
+    uint32_t writeOffset = 0; // offset of first free entry in active sector
+    uint32_t otherEnd = 0;   // offset of end of entries in the other sector
+    uint32_t sequence = 0;   // sequence number of active sector
+    uint32_t readSector = 0; // index of sector to read
+    uint32_t readOffset = 0; // offset of next entry to read
+    bool isNextErased = false; // is the other sector erased by 'prepare'
+
+    /* Check if sector has correct header function.
+     *
+     * Arguments:
+     *   uint32_t index -- sector index
+     *
+     * Returns:
+     *   true if sector is log sector.
+     */
+    static bool isValid(uint32_t index);
+
+    /* Sequence number of sector getter.
+     *
+     * Arguments:
+     *   uint32_t index -- sector index
+     *
+     * Returns:
+     *   Sequence number of sector.
+     */
+    static uint32_t getSequence(uint32_t index);
+
+    /* Find end of entries in sector function.
+     *
+     * Arguments:
+     *   uint32_t index -- sector index
+     *
+     * Returns:
+     *   Offset of first free entry.
+     */
+    static uint32_t findEnd(uint32_t index);
+
+    /* Erase sector (if it is not erased by 'prepare') and make it active function.
+     *
+     * Arguments:
+     *   uint32_t index -- sector index
+     *
+     * Returns:
+     *   true if sector was prepared.
+     */
+    bool startSector(uint32_t index);
+  }; // End of 'PostureLog' class
+} // end of 'mthl' namespace
+
+#endif // __POSTURE_LOG_H_
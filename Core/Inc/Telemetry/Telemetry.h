@@ -0,0 +1,174 @@
+/******************************
+ * File name   : Telemetry.h
+ * Purpose     : Mithril project.
+ *               Binary telemetry protocol declaration
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __TELEMETRY_H_
+#define __TELEMETRY_H_
+
+#include <stdint.h>
+
+/* Mithril namespace */
+namespace mthl
+{
+  /* Binary telemetry protocol.
+   * Frame is COBS-encoded packet followed by zero delimiter byte. Packet consists of
+   * header, payload and CRC16 (CCITT-FALSE: polynomial 0x1021, initial value 0xFFFF)
+   * of header and payload. All numbers are little-endian.
+   *
+   *   offset | size | field
+   *   -------+------+--------------------------------
+   *   0      | 1    | protocol version (VERSION)
+   *   1      | 1    | message type (Message)
+   *   2      | 1    | frame sequence number
+   *   3      | 4    | time of sending (milliseconds)
+   *   7      | N    | payload
+   *   7 + N  | 2    | CRC16
+   *
+   * Physical values are sent as int16 numbers multiplied by scales below.
+   * Decoder is Tools/telemetry_decode.py.
+   */
+  namespace telemetry
+  {
+    static constexpr const uint8_t VERSION = 1; // Protocol version
+
+    /* Message type enum class declaration */
+    enum class Message : uint8_t
+    {
+      RAW_IMU = 1,      // sensor (u8), accelerometer (3 x i16), gyroscope (3 x i16)
+      ANGLES = 2,       // sensor (u8), filtered absolute angles (3 x i16)
+      SPINE_ANGLES = 3, // number of angles (u8), spine angles (i16 each)
+      POSTURE = 4,      // is posture correct (u8)
+      LOG_ENTRIES = 5   // number of entries (u8), posture log entries (2 x u32 each), sent on request
+    }; // End of 'Message' enum class
+
+    static constexpr const float
+      ACCEL_SCALE = 1000,     // accelerometer units per g
+      GYRO_SCALE = 100,       // gyroscope units per degree per second
+      ANGLE_SCALE = 100,      // filtered angle units per degree
+      SPINE_ANGLE_SCALE = 100; // spine angle units per degree
+
+    /* Evaluate CRC16 function.
+     *
+     * Arguments:
+     *   const uint8_t *data -- bytes
+     *   uint32_t len -- number of bytes
+     *
+     * Returns:
+     *   CRC16 (CCITT-FALSE) of bytes.
+     */
+    uint16_t crc16(const uint8_t *data, uint32_t len);
+
+    /* Encode bytes with COBS function.
+     * Encoded bytes contain no zeros. Destination must have place for
+     * len + len / 254 + 1 bytes.
+     *
+     * Arguments:
+     *   const uint8_t *src -- bytes to encode
+     *   uint32_t len -- number of bytes
+     *   uint8_t *dst -- encoded bytes
+     *
+     * Returns:
+     *   Number of encoded bytes.
+     */
+    uint32_t cobsEncode(const uint8_t *src, uint32_t len, uint8_t *dst);
+
+    /* Decode COBS bytes function.
+     *
+     * Arguments:
+     *   const uint8_t *src -- encoded bytes without zero delimiter
+     *   uint32_t len -- number of encoded bytes
+     *   uint8_t *dst -- decoded bytes (it may be equal to src)
+     *
+     * Returns:
+     *   Number of decoded bytes, 0 if encoding is broken.
+     */
+    uint32_t cobsDecode(const uint8_t *src, uint32_t len, uint8_t *dst);
+
+    /* Telemetry frame class declaration.
+     * Collects header and payload of one message and encodes them to frame.
+     * Values which do not fit in payload are dropped.
+     */
+    class Frame final
+    {
+    public:
+      static constexpr const uint32_t
+        HEADER_SIZE = 7,                                     // Size of header
+        MAX_PAYLOAD_SIZE = 32,                               // Maximal size of payload
+        CRC_SIZE = 2,                                        // Size of CRC
+        MAX_PACKET_SIZE = HEADER_SIZE + MAX_PAYLOAD_SIZE + CRC_SIZE, // Maximal size of packet
+        MAX_FRAME_SIZE = MAX_PACKET_SIZE + 2;                // Maximal size with COBS code and delimiter
+
+      /* Frame constructor.
+       *
+       * Arguments:
+       *   Message type -- message type
+       *   uint32_t time -- time of sending (milliseconds)
+       */
+      Frame(Message type, uint32_t time);
+
+      /* Put unsigned byte to payload function.
+       *
+       * Arguments:
+       *   uint8_t value -- value to put
+       *
+       * Returns:
+       *   Reference to frame.
+       */
+      Frame & putU8(uint8_t value);
+
+      /* Put signed 16-bit number to payload function.
+       *
+       * Arguments:
+       *   int16_t value -- value to put
+       *
+       * Returns:
+       *   Reference to frame.
+       */
+      Frame & putI16(int16_t value);
+
+      /* Put unsigned 32-bit number to payload function.
+       *
+       * Arguments:
+       *   uint32_t value -- value to put
+       *
+       * Returns:
+       *   Reference to frame.
+       */
+      Frame & putU32(uint32_t value);
+
+      /* Put scaled physical value to payload function.
+       * Value is rounded and clamped to int16 range.
+       *
+       * Arguments:
+       *   float value -- value to put
+       *   float scale -- units per value unit
+       *
+       * Returns:
+       *   Reference to frame.
+       */
+      Frame & putScaled(float value, float scale);
+
+      /* Encode frame function.
+       *
+       * Arguments:
+       *   uint8_t sequence -- frame sequence number
+       *   uint8_t *dst -- encoded frame (MAX_FRAME_SIZE bytes)
+       *
+       * Returns:
+       *   Number of bytes of frame including zero delimiter.
+       */
+      uint32_t encode(uint8_t sequence, uint8_t *dst);
+
+    private:
+      uint8_t packet[MAX_PACKET_SIZE]; // header, payload and CRC
+      uint32_t size;                   // number of bytes of header and payload
+    }; // End of 'Frame' class
+  } // end of 'telemetry' namespace
+} // end of 'mthl' namespace
+
+#endif // __TELEMETRY_H_
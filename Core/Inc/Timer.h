@@ -0,0 +1,76 @@
+/******************************
+ * File name   : Timer.h
+ * Purpose     : Mithrill project.
+ *               High resolution timer based on DWT cycle counter
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __TIMER_H_
+#define __TIMER_H_
+
+#include "stm32f4xx_hal.h"
+
+/* Mithril namespace */
+namespace mthl
+{
+  namespace timer
+  {
+    /* Functions declarations */
+    inline void init();
+    inline uint32_t getCycles();
+    inline float getElapsed(uint32_t start, uint32_t end);
+
+    /* Functions definitions */
+
+    /* Start cycle counter.
+     * Core clock is gated in sleep mode (__WFI), so counter is kept running
+     * in sleep by debug configuration, otherwise sleep time is lost.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    inline void init()
+    {
+      CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+      DWT->CYCCNT = 0;
+      DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+      DBGMCU->CR |= DBGMCU_CR_DBG_SLEEP;
+    } // End of 'init' function
+
+    /* Get current value of cycle counter
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Number of CPU cycles since start.
+     */
+    inline uint32_t getCycles()
+    {
+      return DWT->CYCCNT;
+    } // End of 'getCycles' function
+
+    /* Get time between two counter values.
+     * Counter overflow is handled, if time is less than one overflow period
+     * (about 268 seconds for 16MHz).
+     *
+     * Arguments:
+     *   uint32_t start -- counter value at start
+     *   uint32_t end -- counter value at end
+     *
+     * Returns:
+     *   Elapsed time in seconds.
+     */
+    inline float getElapsed(uint32_t start, uint32_t end)
+    {
+      return (float)(end - start) / SystemCoreClock;
+    } // End of 'getElapsed' function
+  } // end of 'timer' namespace
+} // end of 'mthl' namespace
+
+#endif // __TIMER_H_
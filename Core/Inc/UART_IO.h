@@ -4,7 +4,7 @@
  *               UART I/O interface
  * Author      : Tarasov Denis
  * Create date : 01.03.2020
- * Last change : 10.03.2020
+ * Last change : 18.10.2026
  ******************************/
 
 #ifndef __UART_IO_H_
@@ -12,13 +12,13 @@
 
 #include "stm32f4xx_hal.h"
 
+#include "UART_TX.h"
+
 // TODO Error handling
 
 /* Mithril namespace */
 namespace mthl
 {
-  static uint8_t UART_buf[19] = {0}, UART_rev[19] = {0}; // Buffers for writing
-
   /* Functions declarations */
 
   /*** Writing ***/
@@ -33,6 +33,204 @@ namespace mthl
   /*** Reading ***/
   inline uint8_t readByte(UART_HandleTypeDef *huart);
 
+  /* Line formatter class declaration.
+   * Renders text to caller-provided buffer and sends it with one transfer by 'flush'
+   * (or destructor). If buffer becomes full, its content is sent and rendering
+   * continues, so nothing is lost. Formatter has no shared state, so different
+   * formatters may be used from main loop and interrupts at once.
+   */
+  class Formatter
+  {
+  public:
+    /* Formatter constructor.
+     *
+     * Arguments:
+     *   UART_HandleTypeDef *huart -- UART handler
+     *   uint8_t *buf -- buffer for rendered text
+     *   uint32_t size -- buffer size
+     */
+    Formatter(UART_HandleTypeDef *huart, uint8_t *buf, uint32_t size) :
+      huart(huart), buf(buf), size(size)
+    {
+    } // End of 'Formatter' constructor
+
+    Formatter(const Formatter &) = delete;
+    Formatter & operator=(const Formatter &) = delete;
+
+    /* Formatter destructor. Sends rest of text */
+    ~Formatter()
+    {
+      flush();
+    } // End of 'Formatter' destructor
+
+    /* Put bytes function.
+     *
+     * Arguments:
+     *   const uint8_t *s -- bytes to put
+     *   uint32_t len -- number of bytes
+     *
+     * Returns:
+     *   Reference to formatter.
+     */
+    Formatter & putBytes(const uint8_t *s, uint32_t len)
+    {
+      if (size == 0)
+      {
+        writeBytes(huart, s, len);
+        return *this;
+      }
+
+      while (len > 0)
+      {
+        if (pos == size)
+          flush();
+
+        uint32_t count = size - pos < len ? size - pos : len;
+
+        for (uint32_t i = 0; i < count; ++i)
+          buf[pos++] = s[i];
+        s += count;
+        len -= count;
+      }
+      return *this;
+    } // End of 'putBytes' function
+
+    /* Put single character function.
+     *
+     * Arguments:
+     *   uint8_t ch -- character to put
+     *
+     * Returns:
+     *   Reference to formatter.
+     */
+    Formatter & putChar(uint8_t ch)
+    {
+      return putBytes(&ch, 1);
+    } // End of 'putChar' function
+
+    /* Put c-style string function.
+     *
+     * Arguments:
+     *   const char *s -- string to put
+     *
+     * Returns:
+     *   Reference to formatter.
+     */
+    Formatter & putWord(const char *s)
+    {
+      uint32_t len = 0;
+
+      while (s[len])
+        len++;
+      return putBytes((const uint8_t *)s, len);
+    } // End of 'putWord' function
+
+    /* Put integer number function.
+     *
+     * Arguments:
+     *   int32_t n -- number to put
+     *
+     * Returns:
+     *   Reference to formatter.
+     */
+    Formatter & putInt(int32_t n)
+    {
+      uint8_t digits[11];
+      uint32_t pos = sizeof(digits);
+      // Magnitude is unsigned, so minimal number is processed too
+      uint32_t value = n < 0 ? 0u - (uint32_t)n : (uint32_t)n;
+
+      // Get all digits from the end
+      do
+      {
+        digits[--pos] = '0' + value % 10;
+        value /= 10;
+      } while (value);
+
+      if (n < 0)
+        digits[--pos] = '-';
+      return putBytes(digits + pos, sizeof(digits) - pos);
+    } // End of 'putInt' function
+
+    /* Put float number function.
+     *
+     * Arguments:
+     *   float n -- number to put
+     *   int32_t precision -- number of digits after the dot (default = 4)
+     *
+     * Returns:
+     *   Reference to formatter.
+     */
+    Formatter & putFloat(float n, int32_t precision = 4)
+    {
+      // Process negative number
+      if (n < 0)
+      {
+        putChar('-');
+        n = -n;
+      }
+      // Put digits before dot
+      putInt((int32_t)n);
+      n -= (int32_t)n;
+      putChar('.');
+
+      // Put digits after dot
+      for (int32_t i = 0; i < precision; ++i)
+      {
+        n *= 10;
+        putChar('0' + (int32_t)n);
+        n -= (int32_t)n;
+      }
+      return *this;
+    } // End of 'putFloat' function
+
+    /* Send rendered text function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void flush()
+    {
+      if (pos == 0)
+        return;
+      writeBytes(huart, buf, pos);
+      pos = 0;
+    } // End of 'flush' function
+
+  private:
+    UART_HandleTypeDef *huart; // UART handler
+    uint8_t *buf;              // buffer for rendered text
+    uint32_t size;             // buffer size
+    uint32_t pos = 0;          // number of rendered bytes
+  }; // End of 'Formatter' class
+
+  /* Line buffer storage structure (it is base of line to be constructed before formatter) */
+  template<uint32_t Size>
+  struct LineStorage
+  {
+    uint8_t storage[Size]; // buffer for rendered text
+  }; // End of 'LineStorage' structure
+
+  /* Line class declaration.
+   * Formatter with its own buffer which is placed on stack of caller.
+   */
+  template<uint32_t Size = 32>
+  class Line final : private LineStorage<Size>, public Formatter
+  {
+  public:
+    /* Line constructor.
+     *
+     * Arguments:
+     *   UART_HandleTypeDef *huart -- UART handler
+     */
+    explicit Line(UART_HandleTypeDef *huart) : Formatter(huart, this->storage, Size)
+    {
+    } // End of 'Line' constructor
+  }; // End of 'Line' class
+
   /* Functions definitions */
 
   /* Write single character with UART
@@ -46,8 +244,10 @@ namespace mthl
    */
   inline void writeChar(UART_HandleTypeDef *huart, int32_t ch)
   {
+    uint8_t byte = (uint8_t)ch;
+
     // Send byte with UART
-    HAL_UART_Transmit(huart, (uint8_t *)&ch, 1, 1000);
+    writeBytes(huart, &byte, 1);
   } // End of 'writeChar' function
 
   /* Write integer number with UART
@@ -62,31 +262,12 @@ namespace mthl
    */
   inline void writeInt(UART_HandleTypeDef *huart, int32_t n, const char *end)
   {
-    int32_t pos = 0;
-    // Process negative number
-    if (n < 0)
-    {
-      writeChar(huart, '-');
-      n = -n;
-    }
-
-    // Get all digits
-    do
-    {
-      UART_buf[pos++] = '0' + n % 10;
-      n /= 10;
-    } while (n);
-
-    // Flip digits
-    for (int32_t i = 0; i < pos; ++i)
-      UART_rev[i] = UART_buf[pos - i - 1];
-    // Write all digits
-
-    writeBytes(huart, UART_rev, pos);
+    Line<> line(huart);
 
+    line.putInt(n);
     // Write postfix
     if (end != nullptr)
-      writeWord(huart, end);
+      line.putWord(end);
   } // End of 'writeInt' function
 
   /* Write float number with UART
@@ -102,46 +283,34 @@ namespace mthl
    */
   inline void writeFloat(UART_HandleTypeDef *huart, float n, const char *end, int32_t precision)
   {
-    // Process negative number
-    if (n < 0)
-    {
-      writeChar(huart, '-');
-      n = -n;
-    }
-    // Write digits before dot
-    writeInt(huart, (int32_t)n);
-    n -= (int32_t)n;
-    writeChar(huart, '.');
-
-    // Write digits after dot to buffer
-    for (int32_t i = 0; i < precision; ++i)
-    {
-      n *= 10;
-      UART_buf[i] = '0' + (int32_t)n;
-      n -= (int32_t)n;
-    }
-
-    // Write buffer
-    writeBytes(huart, UART_buf, precision);
+    Line<> line(huart);
 
+    line.putFloat(n, precision);
     // Write postfix
     if (end != nullptr)
-      writeWord(huart, end);
+      line.putWord(end);
   } // End of 'writeFloat' function
 
   /* Write bytes string with UART
+   * Bytes are queued and sent with DMA if UART has transmit queue,
+   * otherwise function waits till they are sent.
    *
    * Arguments:
    *   UART_HandleTypeDef *huart -- UART handler
    *   const uint8_t *s -- buffer to write
+   *   uint32_t len -- number of bytes
    *
    * Returns:
    *   None.
    */
   inline void writeBytes(UART_HandleTypeDef *huart, const uint8_t *s, uint32_t len)
   {
-    // Write each buffer
-    HAL_UART_Transmit(huart, (uint8_t *)s, len, 1000);
+    TxQueue *queue = TxQueue::find(huart);
+
+    if (queue != nullptr)
+      queue->write(s, len);
+    else
+      HAL_UART_Transmit(huart, (uint8_t *)s, len, 1000);
   } // End of 'writeBytes' function
 
   /* Write c-style string with UART
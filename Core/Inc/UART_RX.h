@@ -0,0 +1,135 @@
+/******************************
+ * File name   : UART_RX.h
+ * Purpose     : Mithrill project.
+ *               UART circular DMA reception
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __UART_RX_H_
+#define __UART_RX_H_
+
+#include "stm32f4xx_hal.h"
+
+/* Received bytes call back function.
+ * Called from UART and DMA interrupts with bytes received since previous call.
+ *
+ * Arguments:
+ *   UART_HandleTypeDef *huart -- UART handler
+ *   const uint8_t *data -- received bytes
+ *   uint32_t len -- number of bytes
+ *
+ * Returns:
+ *   None.
+ */
+void UART_RxEventCallback(UART_HandleTypeDef *huart, const uint8_t *data, uint32_t len);
+
+/* Mithril namespace */
+namespace mthl
+{
+  /* UART reception stream class declaration.
+   * DMA writes received bytes to circular buffer without CPU. Buffer is checked
+   * on idle line, half and whole buffer DMA events, so bytes are passed to
+   * UART_RxEventCallback by bursts instead of interrupt for each byte.
+   * Methods are called from interrupts of the same priority.
+   */
+  class RxStream final
+  {
+  public:
+    static constexpr const uint32_t SIZE = 64; // Circular buffer size
+
+    /* Reception stream constructor.
+     *
+     * Arguments:
+     *   UART_HandleTypeDef *huart -- UART handler (with linked circular RX DMA)
+     */
+    constexpr RxStream(UART_HandleTypeDef *huart) : huart(huart)
+    {
+    } // End of 'RxStream' constructor
+
+    RxStream(const RxStream &) = delete;
+    RxStream & operator=(const RxStream &) = delete;
+
+    /* Find stream of UART function.
+     *
+     * Arguments:
+     *   UART_HandleTypeDef *huart -- UART handler
+     *
+     * Returns:
+     *   Pointer to stream or nullptr if UART has no stream.
+     */
+    static RxStream * find(UART_HandleTypeDef *huart);
+
+    /* Start reception function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   true if reception was started.
+     */
+    bool start();
+
+    /* Pass bytes received since previous call function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void poll();
+
+    /* Reception error processing function.
+     * Errors are counted, reception stopped by HAL is restarted.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void onError();
+
+    /* Number of overrun errors getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Number of overrun errors.
+     */
+    uint32_t getOverrunsCount() const;
+
+    /* Number of framing errors getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Number of framing errors.
+     */
+    uint32_t getFramingErrorsCount() const;
+
+    /* Number of noise and parity errors getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Number of noise and parity errors.
+     */
+    uint32_t getNoiseErrorsCount() const;
+
+  private:
+    UART_HandleTypeDef *huart;           // UART handler
+    uint8_t buffer[SIZE] = {};           // circular buffer written by DMA
+    uint32_t readPos = 0;                // position of first byte which is not passed
+    volatile uint32_t overrunsCount = 0; // number of overrun errors
+    volatile uint32_t framingErrorsCount = 0; // number of framing errors
+    volatile uint32_t noiseErrorsCount = 0;   // number of noise and parity errors
+  }; // End of 'RxStream' class
+} // end of 'mthl' namespace
+
+#endif // __UART_RX_H_
@@ -0,0 +1,166 @@
+/******************************
+ * File name   : UART_TX.h
+ * Purpose     : Mithrill project.
+ *               Non-blocking UART transmit queue
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __UART_TX_H_
+#define __UART_TX_H_
+
+#include "stm32f4xx_hal.h"
+
+/* Mithril namespace */
+namespace mthl
+{
+  /* UART transmit queue class declaration.
+   * Written bytes are put to ring buffer and function returns at once.
+   * Buffer is sent by chunks with DMA, next chunk is started from transfer
+   * completion interrupt. Queue has one writer: bytes are written either from
+   * main loop or from interrupts, not from both.
+   */
+  class TxQueue final
+  {
+  public:
+    /* Policy of writing to full queue enum class declaration */
+    enum class Overflow : uint8_t
+    {
+      DROP_OLDEST, // drop queued bytes which are not sent yet
+      DROP_NEWEST, // drop written bytes which do not fit
+      BLOCK        // wait till bytes are sent (drops newest in interrupts)
+    }; // End of 'Overflow' enum class
+
+    static constexpr const uint32_t SIZE = 512,    // Queue size (power of two)
+                      CHUNK_SIZE = 64;             // Maximal size of one DMA transfer
+
+    /* Transmit queue constructor.
+     *
+     * Arguments:
+     *   UART_HandleTypeDef *huart -- UART handler
+     *   Overflow policy -- policy of writing to full queue
+     */
+    constexpr TxQueue(UART_HandleTypeDef *huart, Overflow policy) : huart(huart), policy(policy)
+    {
+    } // End of 'TxQueue' constructor
+
+    TxQueue(const TxQueue &) = delete;
+    TxQueue & operator=(const TxQueue &) = delete;
+
+    /* Find queue of UART function.
+     *
+     * Arguments:
+     *   UART_HandleTypeDef *huart -- UART handler
+     *
+     * Returns:
+     *   Pointer to queue or nullptr if UART has no queue.
+     */
+    static TxQueue * find(UART_HandleTypeDef *huart);
+
+    /* Put bytes to queue function.
+     *
+     * Arguments:
+     *   const uint8_t *data -- bytes to write
+     *   uint32_t len -- number of bytes
+     *
+     * Returns:
+     *   Number of bytes of data which were queued.
+     */
+    uint32_t write(const uint8_t *data, uint32_t len);
+
+    /* Wait till all queued bytes are sent function.
+     * Called with disabled interrupts, it only starts transfer and keeps them disabled.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void flush();
+
+    /* Check if all queued bytes are sent function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   true if there is nothing to send.
+     */
+    bool isIdle() const;
+
+    /* Overflow policy setter.
+     *
+     * Arguments:
+     *   Overflow policy -- policy of writing to full queue
+     *
+     * Returns:
+     *   None.
+     */
+    void setOverflowPolicy(Overflow policy);
+
+    /* Overflow policy getter.
+     * Arguments:
+     *   None.
+     * Returns:
+     *   Policy of writing to full queue.
+     */
+    Overflow getOverflowPolicy() const;
+
+    /* Number of dropped bytes getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Number of bytes dropped by overflow policy.
+     */
+    uint32_t getDroppedCount() const;
+
+    /* Transfer completion processing function.
+     * Called from UART interrupt context.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void onTxComplete();
+
+    /* Transfer error processing function.
+     * Called from UART interrupt context.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void onTxError();
+
+  private:
+    UART_HandleTypeDef *huart;         // UART handler
+    Overflow policy;                   // policy of writing to full queue
+    uint8_t buffer[SIZE] = {};         // ring buffer of queued bytes
+    uint8_t dmaBuffer[CHUNK_SIZE] = {}; // bytes of current transfer
+    volatile uint32_t head = 0;        // index of next byte to write (it is never wrapped)
+    volatile uint32_t tail = 0;        // index of next byte to send (it is never wrapped)
+    volatile bool isBusy = false;      // is transfer in progress
+    volatile uint32_t droppedCount = 0; // number of dropped bytes
+
+    /* Start transfer of next chunk if UART is free function.
+     * Called with interrupts disabled.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void startTransfer();
+  }; // End of 'TxQueue' class
+} // end of 'mthl' namespace
+
+#endif // __UART_TX_H_
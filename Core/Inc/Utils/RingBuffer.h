@@ -0,0 +1,176 @@
+/******************************
+ * File name   : RingBuffer.h
+ * Purpose     : Mithrill project.
+ *               Lock-free single producer single consumer ring buffer
+ * Author      : Filippov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __RING_BUFFER_H_
+#define __RING_BUFFER_H_
+
+#include <atomic>
+#include <new>
+#include <stdint.h>
+
+/* Mithril namespace */
+namespace mthl
+{
+  /* Ring buffer class declaration.
+   * Fixed capacity queue without dynamic memory. One producer (e.g. interrupt)
+   * may push while one consumer (e.g. main loop) pops without any locks:
+   * producer writes only 'head', consumer writes only 'tail'.
+   * Elements which do not fit are dropped and counted.
+   */
+  template<class Type, uint32_t Capacity>
+  class RingBuffer final
+  {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+        "Ring buffer capacity must be power of two");
+
+  public:
+    /* Ring buffer default constructor */
+    RingBuffer() = default;
+
+    RingBuffer(const RingBuffer &) = delete;
+    RingBuffer & operator=(const RingBuffer &) = delete;
+
+    /* Ring buffer destructor */
+    ~RingBuffer()
+    {
+      while (!empty())
+        pop();
+    } // End of 'RingBuffer' destructor
+
+    /* Put element to buffer function.
+     * Called by producer only.
+     *
+     * Arguments:
+     *   const Type &value -- element to put
+     *
+     * Returns:
+     *   true if element was put, false if buffer is full.
+     */
+    bool push(const Type &value)
+    {
+      uint32_t head = this->head.load(std::memory_order_relaxed);
+
+      if (head - tail.load(std::memory_order_acquire) == Capacity)
+      {
+        overflowsCount.store(overflowsCount.load(std::memory_order_relaxed) + 1,
+            std::memory_order_relaxed);
+        return false;
+      }
+
+      new (slot(head)) Type(value);
+      this->head.store(head + 1, std::memory_order_release);
+      return true;
+    } // End of 'push' function
+
+    /* Get first element function.
+     * Called by consumer only, buffer must not be empty.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Reference to first element.
+     */
+    const Type & front() const
+    {
+      return *slot(tail.load(std::memory_order_relaxed));
+    } // End of 'front' function
+
+    /* Remove first element function.
+     * Called by consumer only, buffer must not be empty.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   None.
+     */
+    void pop()
+    {
+      uint32_t tail = this->tail.load(std::memory_order_relaxed);
+
+      slot(tail)->~Type();
+      this->tail.store(tail + 1, std::memory_order_release);
+    } // End of 'pop' function
+
+    /* Check if buffer is empty function.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   true if there are no elements.
+     */
+    bool empty() const
+    {
+      return size() == 0;
+    } // End of 'empty' function
+
+    /* Number of elements getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Number of elements in buffer.
+     */
+    uint32_t size() const
+    {
+      return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    } // End of 'size' function
+
+    /* Number of dropped elements getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Number of elements which did not fit in buffer.
+     */
+    uint32_t getOverflowsCount() const
+    {
+      return overflowsCount.load(std::memory_order_relaxed);
+    } // End of 'getOverflowsCount' function
+
+  private:
+    alignas(Type) uint8_t storage[Capacity][sizeof(Type)]; // elements memory
+    std::atomic<uint32_t>
+      head{0},           // index of next element to put (it is never wrapped)
+      tail{0},           // index of next element to get (it is never wrapped)
+      overflowsCount{0}; // number of dropped elements
+
+    /* Element memory by index function.
+     *
+     * Arguments:
+     *   uint32_t index -- element index
+     *
+     * Returns:
+     *   Pointer to element memory.
+     */
+    Type * slot(uint32_t index)
+    {
+      return reinterpret_cast<Type *>(storage[index & (Capacity - 1)]);
+    } // End of 'slot' function
+
+    /* Element memory by index function.
+     *
+     * Arguments:
+     *   uint32_t index -- element index
+     *
+     * Returns:
+     *   Pointer to element memory.
+     */
+    const Type * slot(uint32_t index) const
+    {
+      return reinterpret_cast<const Type *>(storage[index & (Capacity - 1)]);
+    } // End of 'slot' function
+  }; // End of 'RingBuffer' class
+} // end of 'mthl' namespace
+
+#endif // __RING_BUFFER_H_
@@ -54,6 +54,8 @@ extern "C" {
 void Error_Handler(void);
 
 /* USER CODE BEGIN EFP */
+/* UART idle line (end of received bytes burst) callback */
+void UART_IdleCallback(UART_HandleTypeDef *huart);
 
 /* USER CODE END EFP */
 
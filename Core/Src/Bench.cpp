@@ -0,0 +1,275 @@
+/******************************
+ * File name   : Bench.cpp
+ * Purpose     : Mithrill project.
+ *               Vector, quaternion and filters math microbenchmarks
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include "Bench.h"
+
+#ifdef MTHL_PROBES
+
+#include "Probe.h"
+#include "Filters/Filters.h"
+#include "Math/fixed.h"
+#include "Math/quater.h"
+
+namespace
+{
+  using mthl::math::fixed;
+  using mthl::math::quater;
+  using mthl::math::vec;
+
+  static constexpr const uint32_t INPUTS_COUNT = 8; // number of different operands
+
+  /* Benchmark operands structure */
+  template<class Type>
+  struct Inputs
+  {
+    quater<Type> q[INPUTS_COUNT], p[INPUTS_COUNT]; // unit quaternions
+    vec<Type> v[INPUTS_COUNT], w[INPUTS_COUNT];    // vectors of length up to 2
+  }; // End of 'Inputs' structure
+
+  /* Make benchmark operands function.
+   *
+   * Arguments:
+   *   None.
+   *
+   * Returns:
+   *   Operands, same on every call.
+   */
+  template<class Type>
+  Inputs<Type> makeInputs()
+  {
+    Inputs<Type> inputs;
+
+    for (uint32_t i = 0; i < INPUTS_COUNT; ++i)
+    {
+      float s, c, t = static_cast<float>(i) / INPUTS_COUNT;
+
+      mthl::math::fastSinCos(0.3f + 2.7f * t, s, c);
+      inputs.q[i] = quater<Type>(Type(c), Type(s * 0.6f), Type(s * -0.48f), Type(s * 0.64f));
+      inputs.p[i] = quater<Type>(Type(s), Type(c * 0.8f), Type(0.0f), Type(c * -0.6f));
+      inputs.v[i] = vec<Type>(Type(c * 2), Type(s - 0.5f), Type(1.0f - t));
+      inputs.w[i] = vec<Type>(Type(t), Type(c), Type(-s * 1.5f));
+    }
+    return inputs;
+  } // End of 'makeInputs' function
+
+  /* Make compiler keep value function.
+   * Value is stored to memory which compiler thinks is read.
+   *
+   * Arguments:
+   *   const Value &value -- value to keep
+   *
+   * Returns:
+   *   None.
+   */
+  template<class Value>
+  inline void keep(const Value &value)
+  {
+    asm volatile("" : : "r"(&value) : "memory");
+  } // End of 'keep' function
+
+  /* Operations. Each one evaluates operation for operands number i */
+  struct QuaterMul
+  {
+    template<class Type>
+    static quater<Type> apply(const Inputs<Type> &in, uint32_t i)
+    {
+      return in.q[i] * in.p[i];
+    }
+  }; // End of 'QuaterMul' structure
+
+  struct QuaterNormalize
+  {
+    template<class Type>
+    static quater<Type> apply(const Inputs<Type> &in, uint32_t i)
+    {
+      return in.p[i].normalize();
+    }
+  }; // End of 'QuaterNormalize' structure
+
+  struct QuaterReciprocal
+  {
+    template<class Type>
+    static quater<Type> apply(const Inputs<Type> &in, uint32_t i)
+    {
+      return in.q[i].reciprocal();
+    }
+  }; // End of 'QuaterReciprocal' structure
+
+  struct QuaterRotate
+  {
+    template<class Type>
+    static vec<Type> apply(const Inputs<Type> &in, uint32_t i)
+    {
+      return in.q[i].rotate(in.v[i]);
+    }
+  }; // End of 'QuaterRotate' structure
+
+  struct VecDot
+  {
+    template<class Type>
+    static Type apply(const Inputs<Type> &in, uint32_t i)
+    {
+      return in.v[i] & in.w[i];
+    }
+  }; // End of 'VecDot' structure
+
+  struct VecCross
+  {
+    template<class Type>
+    static vec<Type> apply(const Inputs<Type> &in, uint32_t i)
+    {
+      return in.v[i] % in.w[i];
+    }
+  }; // End of 'VecCross' structure
+
+  struct VecNormalize
+  {
+    template<class Type>
+    static vec<Type> apply(const Inputs<Type> &in, uint32_t i)
+    {
+      return in.v[i].normalize();
+    }
+  }; // End of 'VecNormalize' structure
+
+  struct FilterComplementary
+  {
+    template<class Type>
+    static quater<Type> apply(const Inputs<Type> &in, uint32_t i)
+    {
+      return mthl::filters::complementary(in.q[i], in.p[i], quater<Type>(0, in.v[i]), 0.01f, 0.04f);
+    }
+  }; // End of 'FilterComplementary' structure
+
+  struct FilterMadgwick
+  {
+    template<class Type>
+    static quater<Type> apply(const Inputs<Type> &in, uint32_t i)
+    {
+      return mthl::filters::madgwick(in.q[i], quater<Type>(0, in.w[i]), quater<Type>(0, in.v[i]), 0.01f, 0.1f);
+    }
+  }; // End of 'FilterMadgwick' structure
+
+  /* Expressions of sensor path with constants of type Literal. Double constants
+   * promote float expressions to double (software floating point on device),
+   * so "double" results are the code before constants were made float.
+   */
+  template<class Literal>
+  struct MadgwickResidual
+  {
+    template<class Type>
+    static Type apply(const Inputs<Type> &in, uint32_t i)
+    {
+      const quater<Type> &q = in.q[i];
+
+      return static_cast<Type>(
+          2 * (Literal(0.5) - Literal(q[1] * q[1]) - Literal(q[2] * q[2])) - Literal(in.v[i][2]));
+    }
+  }; // End of 'MadgwickResidual' structure
+
+  template<class Literal>
+  struct PostureBounds
+  {
+    template<class Type>
+    static bool apply(const Inputs<Type> &in, uint32_t i)
+    {
+      Type bias = in.v[i] & in.w[i];
+
+      return Literal(-0.4) <= Literal(bias) && Literal(bias) <= Literal(0.9);
+    }
+  }; // End of 'PostureBounds' structure
+
+  /* Measure operation function.
+   *
+   * Arguments:
+   *   uint32_t iterations -- number of operations
+   *
+   * Returns:
+   *   Ticks of all operations.
+   */
+  template<class Operation, class Type>
+  uint32_t measure(uint32_t iterations)
+  {
+    Inputs<Type> inputs = makeInputs<Type>();
+
+    // Operands can be changed by 'keep', so operations are not evaluated once before loop
+    keep(inputs);
+    uint32_t start = mthl::probe::now();
+    for (uint32_t i = 0; i < iterations; ++i)
+      keep(Operation::apply(inputs, i % INPUTS_COUNT));
+    return mthl::probe::now() - start;
+  } // End of 'measure' function
+
+  /* Benchmark structure */
+  struct Benchmark
+  {
+    const char *name;                        // operation
+    const char *type;                        // number type
+    uint32_t (*measure)(uint32_t iterations); // measure function
+  }; // End of 'Benchmark' structure
+
+  /* All benchmarks, operation names and types don't change between releases */
+  const Benchmark BENCHMARKS[] =
+  {
+    {"quater_mul", "float", measure<QuaterMul, float>},
+    {"quater_mul", "q16.16", measure<QuaterMul, fixed>},
+    {"quater_normalize", "float", measure<QuaterNormalize, float>},
+    {"quater_normalize", "q16.16", measure<QuaterNormalize, fixed>},
+    {"quater_reciprocal", "float", measure<QuaterReciprocal, float>},
+    {"quater_reciprocal", "q16.16", measure<QuaterReciprocal, fixed>},
+    {"quater_rotate", "float", measure<QuaterRotate, float>},
+    {"quater_rotate", "q16.16", measure<QuaterRotate, fixed>},
+    {"vec_dot", "float", measure<VecDot, float>},
+    {"vec_dot", "q16.16", measure<VecDot, fixed>},
+    {"vec_cross", "float", measure<VecCross, float>},
+    {"vec_cross", "q16.16", measure<VecCross, fixed>},
+    {"vec_normalize", "float", measure<VecNormalize, float>},
+    {"vec_normalize", "q16.16", measure<VecNormalize, fixed>},
+    {"filter_complementary", "float", measure<FilterComplementary, float>},
+    {"filter_madgwick", "float", measure<FilterMadgwick, float>},
+    {"madgwick_residual", "float", measure<MadgwickResidual<float>, float>},
+    {"madgwick_residual", "double", measure<MadgwickResidual<double>, float>},
+    {"posture_bounds", "float", measure<PostureBounds<float>, float>},
+    {"posture_bounds", "double", measure<PostureBounds<double>, float>}
+  };
+}
+
+/* Number of benchmarks getter */
+uint32_t mthl::bench::getCount()
+{
+  return sizeof(BENCHMARKS) / sizeof(BENCHMARKS[0]);
+} // End of 'mthl::bench::getCount' function
+
+/* Run benchmark function */
+mthl::bench::Result mthl::bench::run(uint32_t index, uint32_t iterations)
+{
+  const Benchmark &benchmark = BENCHMARKS[index];
+  Result result = {benchmark.name, benchmark.type, iterations, UINT32_MAX};
+
+  // Fastest run is least disturbed by interrupts
+  for (uint32_t i = 0; i < REPEATS; ++i)
+  {
+    uint32_t ticks = benchmark.measure(iterations);
+
+    if (ticks < result.ticks)
+      result.ticks = ticks;
+  }
+  return result;
+} // End of 'mthl::bench::run' function
+
+/* Ticks unit name getter */
+const char * mthl::bench::getUnit()
+{
+#ifdef MTHL_PROBES_CHRONO
+  return "ns";
+#else
+  return "cycles";
+#endif
+} // End of 'mthl::bench::getUnit' function
+
+#endif // MTHL_PROBES
@@ -5,15 +5,18 @@
  *               Controller class implementation.
  * Author      : Filippov Denis
  * Create date : 09.03.2020.
- * Last change : 13.05.2020.
+ * Last change : 18.10.2026.
  ******************************/
 
+#include <utility>
+
 #include "stm32f4xx_hal.h"
 #include "Controller/Controller.h"
 
 #include "Sensors/MCU6050.h"
 #include "Controller/Functionality/Health/Posture/Posture.h"
 #include "UART_IO.h"
+#include "Power.h"
 
 extern I2C_HandleTypeDef hi2c1;
 extern I2C_HandleTypeDef hi2c3;
@@ -22,14 +25,82 @@ extern UART_HandleTypeDef huart6;
 
 extern bool isFirstColibProc;
 
+namespace
+{
+  /* IMU-sensor connection structure */
+  struct SensorConnection
+  {
+    I2C_HandleTypeDef *handle; // I2C handler
+    uint8_t addr;              // device address
+    uint16_t dataReadyPin;     // EXTI pin connected to device INT pin
+    mthl::filters::Type filter; // orientation filter of device
+  };
+
+  /* Connections of IMU-sensors in order along spine */
+  const SensorConnection CONNECTIONS[] =
+  {
+    {&hi2c1, mthl::MCU6050::MPU6050_ADDR_1, GPIO_PIN_0, mthl::filters::Type::COMPLEMENTARY},
+    {&hi2c3, mthl::MCU6050::MPU6050_ADDR_1, GPIO_PIN_1, mthl::filters::Type::COMPLEMENTARY},
+    {&hi2c1, mthl::MCU6050::MPU6050_ADDR_2, GPIO_PIN_2, mthl::filters::Type::COMPLEMENTARY}
+  };
+
+  static_assert(sizeof(CONNECTIONS) / sizeof(CONNECTIONS[0]) == mthl::SENSORS_COUNT,
+      "Every IMU-sensor must have connection");
+
+  /* Create IMU-sensors in place function.
+   *
+   * Arguments:
+   *   std::index_sequence<Index...> -- numbers of sensors
+   *
+   * Returns:
+   *   Sensors connected as CONNECTIONS describe.
+   */
+  template<std::size_t ...Index>
+  std::array<mthl::MCU6050, sizeof...(Index)> makeSensors(std::index_sequence<Index...>)
+  {
+    return {{mthl::MCU6050(CONNECTIONS[Index].handle, CONNECTIONS[Index].addr)...}};
+  } // End of 'makeSensors' function
+}
+
 /* Controller default constructor */
 mthl::Controller::Controller()
+  : IMUSensors(makeSensors(std::make_index_sequence<SENSORS_COUNT>())),
+    sensorsUpdate(makeSensorSet(IMUSensors)), telemetryStream(makeSensorSet(IMUSensors)),
+    posture(makeSensorSet(IMUSensors)), logDownload(postureLog),
+    logMaintenance(postureLog)
 {
-  IMUSensors.emplace_back(std::make_unique<MCU6050>(&hi2c1, uint8_t(MCU6050::MPU6050_ADDR_1)));
-  IMUSensors.emplace_back(std::make_unique<MCU6050>(&hi2c3, uint8_t(MCU6050::MPU6050_ADDR_1)));
-  IMUSensors.emplace_back(std::make_unique<MCU6050>(&hi2c1, uint8_t(MCU6050::MPU6050_ADDR_2)));
-  //mithrilFuncs.push_back({new PostureProcML(IMUSensors), true});
-  mithrilFuncs.push_back({new PostureProcASF(IMUSensors), true});
+  // Sensors are calibrated only if there is no stored calibration for them,
+  // offline sensors can't be calibrated and are not stored
+  bool isCalibrationChanged = false;
+
+  calibrationStore.load();
+
+  for (std::size_t i = 0; i < SENSORS_COUNT; ++i)
+  {
+    MCU6050 &sensor = IMUSensors[i];
+    const SensorConnection &con = CONNECTIONS[i];
+
+    if (!calibrationStore.restore(sensor) && sensor.calibrate(100))
+    {
+      calibrationStore.put(sensor);
+      isCalibrationChanged = true;
+    }
+    sensor.setFilter(con.filter);
+
+    if (!IS_SENSORS_FIFO_ON || !sensor.enableFifo())
+      // Sensor without data ready interrupt is read together with others
+      sampler.addSensor(&sensor, sensor.enableDataReadyInt() ? con.dataReadyPin : 0);
+  }
+  if (isCalibrationChanged)
+    calibrationStore.save();
+  postureLog.init();
+  // Sensors read with DMA are updated right after reading, others keep data in FIFO
+  if (IS_SENSORS_FIFO_ON)
+    scheduler.addTask(&sensorsUpdate, SENSORS_FIFO_PERIOD);
+  scheduler.addTask(&posture, POSTURE_PERIOD);
+  scheduler.addTask(&telemetryStream, TELEMETRY_PERIOD);
+  scheduler.addTask(&logDownload, LOG_DOWNLOAD_PERIOD);
+  scheduler.addTask(&logMaintenance, LOG_MAINTENANCE_PERIOD);
 } // End of 'mthl::Controller::Controller' constructor
 
 /* Getting instance of controller function */
@@ -49,6 +120,9 @@ void mthl::Controller::Run()
   /* Initialize state of request */
   Request::State state = Request::State::OK;
 
+  /* Read first sample set. Next sets are read when all sensors have fresh data */
+  sampler.start();
+
   /* Main loop of getting requests */
   while (state != Request::State::EXIT)
   {
@@ -69,10 +143,26 @@ void mthl::Controller::Run()
       reqQueue.pop();
     }
 
-    /* Process all powered on functions */
-    for (auto mF : mithrilFuncs)
-      if (mF.second)
-        mF.first->doFunction();
+    /* Filter new sample set as soon as it is read.
+     * Sets are read with DMA while requests and functions are processed.
+     */
+    if (sampler.dispatch())
+      sensorsUpdate.doFunction();
+    /* Next set and next transfers are started here, interrupts only request them.
+     * Set is also started when data ready pins are silent for too long.
+     */
+    sampler.start();
+
+    /* Process functions which periods are passed */
+    scheduler.run();
+
+    /* Sleep till next function or interrupt if there is nothing to do.
+     * Interrupts are disabled, so event which comes after the check still wakes CPU.
+     */
+    __disable_irq();
+    if (reqQueue.empty() && !sampler.isReady() && !sampler.isPending())
+      power::sleep(scheduler.getTimeToNext());
+    __enable_irq();
   }
 
 } // End of 'mthl::Controller::Run' function
@@ -89,10 +179,111 @@ void mthl::Controller::isPostureOnSet(bool value)
   isPostureOn = value;
 }
 
+/* isTelemetryOn getter */
+bool mthl::Controller::isTelemetryOnGet()
+{
+  return telemetryMask != 0;
+}
+
+/* isTelemetryOn setter */
+void mthl::Controller::isTelemetryOnSet(bool value)
+{
+  telemetryMask = value ? 0xFF : 0;
+}
+
+/* Check if telemetry message is subscribed function */
+bool mthl::Controller::isTelemetrySubscribed(telemetry::Message type)
+{
+  return telemetryMask & 1 << (static_cast<uint8_t>(type) - 1);
+}
+
+/* Telemetry subscription setter */
+void mthl::Controller::setTelemetryMask(uint8_t mask)
+{
+  telemetryMask = mask;
+}
+
+/* Set bounds of correct spine angle function */
+bool mthl::Controller::setPostureBounds(uint32_t angle, float minValue, float maxValue)
+{
+  return posture.setBounds(angle, minValue, maxValue);
+}
+
+/* Set complementary filter time constant of all sensors function */
+void mthl::Controller::setFilterTimeConst(float timeConst)
+{
+  for (auto &imu : IMUSensors)
+    imu.setFilterTimeConst(timeConst);
+}
+
+/* Set sampling period of all sensors function */
+bool mthl::Controller::setSamplePeriod(uint32_t period)
+{
+  bool isSet = true;
+
+  // Sensors are set up with blocking writing
+  pauseSampling();
+  for (auto &imu : IMUSensors)
+    isSet &= imu.setSamplePeriod(period);
+  resumeSampling();
+  return isSet;
+}
+
+/* Stop reading of IMU-sensors function */
+void mthl::Controller::pauseSampling()
+{
+  sampler.setPaused(true);
+  while (sampler.isBusy())
+  {
+    sampler.service();
+    // Transfer completion interrupt wakes CPU
+    __WFI();
+  }
+  sampler.drop();
+} // End of 'mthl::Controller::pauseSampling' function
+
+/* Resume reading of IMU-sensors function */
+void mthl::Controller::resumeSampling()
+{
+  sampler.setPaused(false);
+  sampler.start();
+} // End of 'mthl::Controller::resumeSampling' function
+
+/* Number of dropped command frames getter */
+uint32_t mthl::Controller::getCommandErrorsCount()
+{
+  return cmdParser.getErrorsCount();
+}
+
+/* Posture history log getter */
+mthl::PostureLog & mthl::Controller::getPostureLog()
+{
+  return postureLog;
+}
+
+/* Start sending posture log to application function */
+void mthl::Controller::downloadLog()
+{
+  logDownload.start();
+}
+
 /* Calibrate devices */
 void mthl::Controller::calibrate()
 {
+  // Calibration uses blocking reading
+  pauseSampling();
+
+  bool isCalibrationChanged = false;
+
+  // Stored calibration of offline sensor is kept
   for (auto &imu : IMUSensors)
-    imu->calibrate(50);
+    if (imu.calibrate(50))
+    {
+      calibrationStore.put(imu);
+      isCalibrationChanged = true;
+    }
+  if (isCalibrationChanged)
+    calibrationStore.save();
   isFirstColibProc = true;
+  resumeSampling();
 }
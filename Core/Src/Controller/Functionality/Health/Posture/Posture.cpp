@@ -6,7 +6,7 @@
  * Author      : Filippov Denis
  *               Tarasov Denis
  * Create date : 04.04.2020
- * Last change : 27.05.2020
+ * Last change : 18.10.2026
  ******************************/
 
 #include "stm32f4xx_hal.h"
@@ -19,28 +19,49 @@ extern UART_HandleTypeDef huart2;
 extern UART_HandleTypeDef huart6;
 
 bool isFirstColibProc = true;
-/* Posture processing by machine learning constructor */
-mthl::PostureProcML::PostureProcML(const std::vector<std::unique_ptr<IMU>> &IMUSensors) : IMUSens(IMUSensors)
+
+namespace
 {
+  /* Send posture verdict to application function.
+   * Verdict is sent as telemetry frame if it is subscribed, as text while telemetry is off.
+   *
+   * Arguments:
+   *   bool isPostureCorrect -- is posture correct
+   *
+   * Returns:
+   *   None.
+   */
+  void reportPosture(bool isPostureCorrect)
+  {
+    auto &controller = mthl::Controller::getInstance();
 
-} // End of 'mthl::PostureProcML::PostureProcML' constructor
+    controller.getPostureLog().append(mthl::PostureLog::Event::POSTURE, isPostureCorrect);
+    if (controller.isTelemetrySubscribed(mthl::telemetry::Message::POSTURE))
+    {
+      mthl::telemetry::Frame frame(mthl::telemetry::Message::POSTURE, HAL_GetTick());
 
-/* Doing posture processing function */
-void mthl::PostureProcML::doFunction()
+      frame.putU8(isPostureCorrect);
+      mthl::TelemetryStream::send(frame);
+    }
+    else if (!controller.isTelemetryOnGet())
+      mthl::writeWord(&huart6, isPostureCorrect ? " Good\n" : " Bad\n");
+  } // End of 'reportPosture' function
+}
+/* Posture processing by machine learning constructor */
+mthl::PostureProcML::PostureProcML(const SensorSet &IMUSensors) : IMUSens(IMUSensors)
 {
-  if (!mthl::Controller::getInstance().isPostureOnGet())
-    return;
-
-  auto deviceAngles1 = IMUSens[0]->getAnglesOfDefl(),
-    deviceAngles2 = IMUSens[1]->getAnglesOfDefl(),
-    deviceAngles3 = IMUSens[2]->getAnglesOfDefl();
 
-  mthl::math::quater<float> deviceGravity1, deviceGravity2, deviceGravity3;
+} // End of 'mthl::PostureProcML::PostureProcML' constructor
 
-  IMUSens[0]->readAccel(deviceGravity1);
-  IMUSens[1]->readAccel(deviceGravity2);
-  IMUSens[2]->readAccel(deviceGravity3);
+/* Evaluate posture function */
+bool mthl::PostureProcML::evaluate()
+{
+  MTHL_PROBE(POSTURE);
+  auto deviceAngles1 = std::get<0>(IMUSens)->getAnglesOfDefl(),
+    deviceAngles2 = std::get<1>(IMUSens)->getAnglesOfDefl(),
+    deviceAngles3 = std::get<2>(IMUSens)->getAnglesOfDefl();
 
+  // Gravity terms are not used, so accelerometers are not read (it is blocking bus reading)
   float realBias  = (a11 * deviceAngles1[0] + a12 * deviceAngles1[1] + a13 * deviceAngles1[2] +
       //g11 * deviceGravity1[0] + g12 * deviceGravity1[1] + g13 * deviceGravity1[2] +
       a21 * deviceAngles2[0] + a22 * deviceAngles2[1] + a23 * deviceAngles2[2] +
@@ -48,51 +69,65 @@ void mthl::PostureProcML::doFunction()
       a41 * deviceAngles3[0] + a42 * deviceAngles3[1] + a43 * deviceAngles3[2]);
       //g41 * deviceGravity3[0] + g42 * deviceGravity3[1] + g43 * deviceGravity3[2]);/// > bias;
 
-  static bool prev = false;
-  bool isPostureCorrect = (-0.4 <= realBias && realBias <= 0.9);
-  if (isFirstColibProc)
-  {
-    if (isPostureCorrect)
-        mthl::writeWord(&huart6, " Good\n");
-    else
-      mthl::writeWord(&huart6, " Bad\n");
+  return -0.4f <= realBias && realBias <= 0.9f;
+} // End of 'mthl::PostureProcML::evaluate' function
 
-    isFirstColibProc = false;
-  }
-  else if (isPostureCorrect != prev)
-  {
-    if (isPostureCorrect)
-      mthl::writeWord(&huart6, " Good\n");
-    else
-      mthl::writeWord(&huart6, " Bad\n");
-  }
-  prev = isPostureCorrect;
+/* Doing posture processing function */
+void mthl::PostureProcML::doFunction()
+{
+  if (!mthl::Controller::getInstance().isPostureOnGet())
+    return;
 
-  HAL_Delay(20);
+  static bool prev = false;
+  bool isPostureCorrect = evaluate();
+  if (isFirstColibProc || isPostureCorrect != prev)
+    reportPosture(isPostureCorrect);
+  isFirstColibProc = false;
+  prev = isPostureCorrect;
 } // End of 'mthl::PostureProcML::doFunction' function
 
 
 namespace
 {
   /// Number of point == 5
-  static const std::vector<float> dists = {16, 11, 17, 16, 0};
+  constexpr const std::array<float, 5> dists = {16, 11, 17, 16, 0};
       //{14.5, 9.5, 17.5, 18, 0};
 }
 /* Posture processing by approximation to function constructor */
-mthl::PostureProcASF::PostureProcASF(const std::vector<std::unique_ptr<IMU>> &IMUSensors)
-  : IMUSens(IMUSensors), SPFunc(dists)
+mthl::PostureProcASF::PostureProcASF(const SensorSet &IMUSensors)
+  : IMUSens(IMUSensors), SPFunc(dists), angles
+  {{
+    {{dists[0] + dists[1], dists[0] + dists[1] + dists[2],
+      dists[0] + dists[1] + dists[2] + dists[3]}, 139, 152}, // upper angle, C3-TH5-L3
+    {{0, dists[0], dists[0] + dists[1]}, 137, 153},           // lower angle, TH5-L3-as
+  }}
 {
 } // End of 'mthl::PostureProcASF::PostureProcASF' constructor
 
-/* Doing posture processing function */
-void mthl::PostureProcASF::doFunction()
+/* Set bounds of correct spine angle function */
+bool mthl::PostureProcASF::setBounds(uint32_t angle, float minValue, float maxValue)
 {
-  if (!mthl::Controller::getInstance().isPostureOnGet())
-    return;
+  if (angle >= ANGLES_COUNT || minValue > maxValue)
+    return false;
+  angles[angle].minValue = minValue;
+  angles[angle].maxValue = maxValue;
+  return true;
+} // End of 'mthl::PostureProcASF::setBounds' function
+
+/* Spine angles getter */
+const std::array<float, mthl::PostureProcASF::ANGLES_COUNT> & mthl::PostureProcASF::getSpineAngles() const
+{
+  return spineAngles;
+} // End of 'mthl::PostureProcASF::getSpineAngles' function
+
+/* Evaluate posture function */
+bool mthl::PostureProcASF::evaluate()
+{
+  MTHL_PROBE(POSTURE);
   // take angles
-  auto deviceAngles1 = IMUSens[0]->getAbsAngles(),
-    deviceAngles2 = IMUSens[1]->getAbsAngles(),
-    deviceAngles3 = IMUSens[2]->getAbsAngles();
+  auto deviceAngles1 = std::get<0>(IMUSens)->getAbsAngles(),
+    deviceAngles2 = std::get<1>(IMUSens)->getAbsAngles(),
+    deviceAngles3 = std::get<2>(IMUSens)->getAbsAngles();
 
   // Correction of angles
   deviceAngles1[0] += spineApproxFunc::PI / 2;
@@ -101,56 +136,63 @@ void mthl::PostureProcASF::doFunction()
 
   // update angles
   // TODO: check axis of angles. Result -- we need axis [0]
-  SPFunc.updateAngles({{deviceAngles1[0], deviceAngles1[0]},
-                       {deviceAngles1[0], deviceAngles2[0]},
-                       {deviceAngles2[0], deviceAngles2[0]},
-                       {deviceAngles2[0], deviceAngles3[0]},
-                       {deviceAngles3[0], deviceAngles3[0]}});
-
-  // get angle by distances of points on
-  struct angle
-  {
-    const std::array<float, 3> dists{};
-    const float minValue, maxValue;
-    bool check(float angle) const
-    {
-      return minValue <= angle && angle <= maxValue;
-    }
-  };
+  SPFunc.updateAngles({{{deviceAngles1[0], deviceAngles1[0]},
+                        {deviceAngles1[0], deviceAngles2[0]},
+                        {deviceAngles2[0], deviceAngles2[0]},
+                        {deviceAngles2[0], deviceAngles3[0]},
+                        {deviceAngles3[0], deviceAngles3[0]}}});
 
-  // TODO: add distances
-  static const angle angles[] =
+  bool isPostureCorrect = true;
+  for (uint32_t i = 0; i < ANGLES_COUNT; ++i)
   {
-    {{dists[0] + dists[1], dists[0] + dists[1] + dists[2],
-      dists[0] + dists[1] + dists[2] + dists[3]}, 139, 152}, // upper angle, C3-TH5-L3
-    {{0, dists[0], dists[0] + dists[1]}, 137, 153}, // lower angle, TH5-L3-as
-  };
+    spineAngles[i] = SPFunc.getAngle(angles[i].dists);
+    isPostureCorrect &= angles[i].check(spineAngles[i]);
+  }
+  return isPostureCorrect;
+} // End of 'mthl::PostureProcASF::evaluate' function
+
+/* Doing posture processing function */
+void mthl::PostureProcASF::doFunction()
+{
+  if (!mthl::Controller::getInstance().isPostureOnGet())
+    return;
 
   static bool prev = false;
-  bool isPostureCorrect = true;
-  float angleReal[2] = {SPFunc.getAngle(angles[0].dists), SPFunc.getAngle(angles[1].dists)};
-  isPostureCorrect &= angles[0].check(angleReal[0]);
-  isPostureCorrect &= angles[1].check(angleReal[1]);
+  bool isPostureCorrect = evaluate();
 
-  if (isFirstColibProc)
+  if (mthl::Controller::getInstance().isTelemetrySubscribed(telemetry::Message::SPINE_ANGLES))
   {
-    if (isPostureCorrect)
-        mthl::writeWord(&huart6, " Good\n");
-    else
-      mthl::writeWord(&huart6, " Bad\n");
+    telemetry::Frame frame(telemetry::Message::SPINE_ANGLES, HAL_GetTick());
 
-    isFirstColibProc = false;
+    frame.putU8(2);
+    frame.putScaled(spineAngles[0], telemetry::SPINE_ANGLE_SCALE);
+    frame.putScaled(spineAngles[1], telemetry::SPINE_ANGLE_SCALE);
+    TelemetryStream::send(frame);
   }
-  else if (isPostureCorrect != prev)
+
+  // Mean angles are logged periodically, so log keeps spine history between verdicts
+  uint32_t time = HAL_GetTick();
+
+  anglesSum[0] += spineAngles[0];
+  anglesSum[1] += spineAngles[1];
+  ++anglesCount;
+  if (time - summaryStart >= SUMMARY_PERIOD)
   {
-    if (isPostureCorrect)
-      mthl::writeWord(&huart6, " Good\n");
-    else
-      mthl::writeWord(&huart6, " Bad\n");
+    uint16_t
+      upper = (uint16_t)(int16_t)(anglesSum[0] / anglesCount * telemetry::SPINE_ANGLE_SCALE),
+      lower = (uint16_t)(int16_t)(anglesSum[1] / anglesCount * telemetry::SPINE_ANGLE_SCALE);
+
+    mthl::Controller::getInstance().getPostureLog().append(PostureLog::Event::ANGLES,
+        upper | (uint32_t)lower << 16);
+    anglesSum = {};
+    anglesCount = 0;
+    summaryStart = time;
   }
-  prev = isPostureCorrect;
 
-  HAL_Delay(100);
+  if (isFirstColibProc || isPostureCorrect != prev)
+    reportPosture(isPostureCorrect);
+  isFirstColibProc = false;
+  prev = isPostureCorrect;
 } // End of 'mthl::PostureProcASF::doFunction' function
 
 
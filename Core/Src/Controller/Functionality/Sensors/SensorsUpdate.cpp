@@ -0,0 +1,24 @@
+/******************************
+ * File name   : SensorsUpdate.cpp
+ * Purpose     : Mithril project.
+ *               Mithril functionality module.
+ *               IMU-sensors update class implementation module.
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include "Controller/Functionality/Sensors/SensorsUpdate.h"
+
+/* IMU-sensors update constructor */
+mthl::SensorsUpdate::SensorsUpdate(const SensorSet &IMUSensors)
+  : IMUSens(IMUSensors)
+{
+} // End of 'mthl::SensorsUpdate::SensorsUpdate' constructor
+
+/* Doing sensors update function */
+void mthl::SensorsUpdate::doFunction()
+{
+  for (auto &imu : IMUSens)
+    imu->update();
+} // End of 'mthl::SensorsUpdate::doFunction' function
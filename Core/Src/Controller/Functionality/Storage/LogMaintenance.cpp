@@ -0,0 +1,33 @@
+/******************************
+ * File name   : LogMaintenance.cpp
+ * Purpose     : Mithril project.
+ *               Mithril functionality module.
+ *               Posture log maintenance class implementation module.
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include "Controller/Functionality/Storage/LogMaintenance.h"
+#include "Controller/Functionality/Telemetry/TelemetryStream.h"
+#include "Controller/Controller.h"
+
+/* Posture log maintenance constructor */
+mthl::LogMaintenance::LogMaintenance(PostureLog &log) : log(log)
+{
+} // End of 'mthl::LogMaintenance::LogMaintenance' constructor
+
+/* Doing log maintenance function */
+void mthl::LogMaintenance::doFunction()
+{
+  if (!log.isPrepareNeeded())
+    return;
+
+  // Transfers are not left in progress: their interrupts wait for erasing to finish
+  Controller &controller = Controller::getInstance();
+
+  controller.pauseSampling();
+  TelemetryStream::flush();
+  log.prepare();
+  controller.resumeSampling();
+} // End of 'mthl::LogMaintenance::doFunction' function
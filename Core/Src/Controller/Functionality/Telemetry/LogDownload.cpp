@@ -0,0 +1,45 @@
+/******************************
+ * File name   : LogDownload.cpp
+ * Purpose     : Mithril project.
+ *               Mithril functionality module.
+ *               Posture log downloading class implementation module.
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include "Controller/Functionality/Telemetry/LogDownload.h"
+#include "Controller/Functionality/Telemetry/TelemetryStream.h"
+
+/* Posture log downloading constructor */
+mthl::LogDownload::LogDownload(PostureLog &log) : log(log)
+{
+} // End of 'mthl::LogDownload::LogDownload' constructor
+
+/* Start downloading from the oldest entry function */
+void mthl::LogDownload::start()
+{
+  log.rewind();
+  isActive = true;
+} // End of 'mthl::LogDownload::start' function
+
+/* Doing log downloading function */
+void mthl::LogDownload::doFunction()
+{
+  for (uint32_t i = 0; i < FRAMES_PER_RUN && isActive; ++i)
+  {
+    PostureLog::Entry entries[ENTRIES_PER_FRAME];
+    uint32_t count = 0;
+
+    while (count < ENTRIES_PER_FRAME && log.read(entries[count]))
+      ++count;
+
+    telemetry::Frame frame(telemetry::Message::LOG_ENTRIES, HAL_GetTick());
+
+    frame.putU8(count);
+    for (uint32_t j = 0; j < count; ++j)
+      frame.putU32(entries[j].header).putU32(entries[j].data);
+    TelemetryStream::send(frame);
+    isActive = count != 0;
+  }
+} // End of 'mthl::LogDownload::doFunction' function
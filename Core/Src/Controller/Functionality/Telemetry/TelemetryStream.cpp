@@ -0,0 +1,79 @@
+/******************************
+ * File name   : TelemetryStream.cpp
+ * Purpose     : Mithril project.
+ *               Mithril functionality module.
+ *               Telemetry streaming class implementation module.
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include "Controller/Functionality/Telemetry/TelemetryStream.h"
+#include "Controller/Controller.h"
+#include "UART_IO.h"
+#include "UART_TX.h"
+
+/* UART handler 6 (for bluetooth) */
+extern UART_HandleTypeDef huart6;
+
+/* Telemetry streaming constructor */
+mthl::TelemetryStream::TelemetryStream(const SensorSet &IMUSensors)
+  : IMUSens(IMUSensors)
+{
+} // End of 'mthl::TelemetryStream::TelemetryStream' constructor
+
+/* Doing telemetry streaming function */
+void mthl::TelemetryStream::doFunction()
+{
+  auto &controller = mthl::Controller::getInstance();
+  bool
+    isRawOn = controller.isTelemetrySubscribed(telemetry::Message::RAW_IMU),
+    isAnglesOn = controller.isTelemetrySubscribed(telemetry::Message::ANGLES);
+
+  if (!isRawOn && !isAnglesOn)
+    return;
+
+  uint32_t time = HAL_GetTick();
+
+  for (uint32_t i = 0; i < IMUSens.size(); ++i)
+  {
+    if (isRawOn)
+    {
+      IMU::Sample sample = IMUSens[i]->getLastSample();
+      telemetry::Frame raw(telemetry::Message::RAW_IMU, time);
+
+      raw.putU8(i);
+      for (int32_t axis = 0; axis < 3; ++axis)
+        raw.putScaled(sample.accel[axis], telemetry::ACCEL_SCALE);
+      for (int32_t axis = 0; axis < 3; ++axis)
+        raw.putScaled(sample.gyro[axis], telemetry::GYRO_SCALE);
+      send(raw);
+    }
+
+    if (isAnglesOn)
+    {
+      math::quater<float> angles = IMUSens[i]->getAbsAngles();
+      telemetry::Frame filtered(telemetry::Message::ANGLES, time);
+
+      filtered.putU8(i);
+      for (int32_t axis = 0; axis < 3; ++axis)
+        filtered.putScaled(angles[axis], telemetry::ANGLE_SCALE);
+      send(filtered);
+    }
+  }
+} // End of 'mthl::TelemetryStream::doFunction' function
+
+/* Send frame to application link function */
+void mthl::TelemetryStream::send(telemetry::Frame &frame)
+{
+  static uint8_t sequence = 0;
+  uint8_t buf[telemetry::Frame::MAX_FRAME_SIZE];
+
+  writeBytes(&huart6, buf, frame.encode(sequence++, buf));
+} // End of 'mthl::TelemetryStream::send' function
+
+/* Wait till sent frames leave application link function */
+void mthl::TelemetryStream::flush()
+{
+  TxQueue::find(&huart6)->flush();
+} // End of 'mthl::TelemetryStream::flush' function
@@ -0,0 +1,105 @@
+/******************************
+ * File name   : CommandParser.cpp
+ * Purpose     : Mithrill project.
+ *               Controller module.
+ *               Command frames parser class implementation.
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include "Controller/Request/CommandParser.h"
+#include "Telemetry/Telemetry.h"
+
+/* Process received byte function */
+bool mthl::CommandParser::feed(uint8_t byte, Request &request)
+{
+  uint32_t time = HAL_GetTick();
+
+  // Pause inside frame means it was lost or its zero byte was stray
+  if (isInFrame && time - lastByteTime > FRAME_TIMEOUT)
+  {
+    // Too long frame is already counted
+    if (!isDiscarding)
+      errorsCount++;
+    isInFrame = false;
+    isDiscarding = false;
+  }
+
+  if (!isInFrame)
+  {
+    // Zero starts frame, other bytes are commands without arguments
+    if (byte == 0)
+    {
+      isInFrame = true;
+      isDiscarding = false;
+      frameSize = 0;
+      lastByteTime = time;
+      return false;
+    }
+    if (!Request::isCommand(byte))
+      return false;
+    request = Request(byte);
+    return true;
+  }
+  lastByteTime = time;
+
+  if (byte != 0)
+  {
+    // Too long frame is dropped at once, its other bytes are not commands
+    if (isDiscarding)
+      return false;
+    if (frameSize == MAX_FRAME_SIZE)
+    {
+      isDiscarding = true;
+      errorsCount++;
+    }
+    else
+      frame[frameSize++] = byte;
+    return false;
+  }
+
+  // Zero ends dropped frame
+  if (isDiscarding)
+  {
+    isInFrame = false;
+    isDiscarding = false;
+    return false;
+  }
+
+  // Repeated zero may start frame as well as end it
+  if (frameSize == 0)
+    return false;
+  isInFrame = false;
+
+  if (!decode(request))
+  {
+    errorsCount++;
+    return false;
+  }
+  return true;
+} // End of 'mthl::CommandParser::feed' function
+
+/* Number of dropped frames getter */
+uint32_t mthl::CommandParser::getErrorsCount() const
+{
+  return errorsCount;
+} // End of 'mthl::CommandParser::getErrorsCount' function
+
+/* Decode received frame function */
+bool mthl::CommandParser::decode(Request &request)
+{
+  uint32_t size = telemetry::cobsDecode(frame, frameSize, frame);
+
+  // Version, command and CRC are required
+  if (size < 4 || frame[0] != telemetry::VERSION)
+    return false;
+  size -= 2;
+  if (telemetry::crc16(frame, size) != (frame[size] | frame[size + 1] << 8))
+    return false;
+  if (!Request::isCommand(frame[1]))
+    return false;
+
+  request = Request(frame[1], frame + 2, size - 2);
+  return true;
+} // End of 'mthl::CommandParser::decode' function
@@ -6,12 +6,15 @@
  * Author      : Filippov Denis
  *               Tarasov Denis
  * Create date : 10.03.2020
- * Last change : 18.05.2020
+ * Last change : 18.10.2026
  ******************************/
 
 #include "Controller/Request/Request.h"
 #include "Controller/Controller.h"
 #include "UART_IO.h"
+#include "Power.h"
+#include "Probe.h"
+#include "Bench.h"
 
 /* There are some externs. I don't think, that we have avoid it in this situation,
  * because there isn't any other places, where we need UART (for now).
@@ -21,85 +24,327 @@ extern UART_HandleTypeDef huart2;
 /* UART handler 6 (for bluetooth) */
 extern UART_HandleTypeDef huart6;
 
-/* Map who mathes byte and it command */
-std::map<uint8_t, mthl::Request::Command> mthl::Request::fromByteToCmdMap =
-{
-  {'1', Command::POWER_ON_LED},
-  {'2', Command::POWER_OFF_LED},
-  {'P', Command::POSTURE_ON},
-  {'D', Command::POSTURE_OFF},
-  {'C', Command::CALIBRATE}
-};
-
 /* Time variable, will be deleted. It helps to power on LD2 */
 static bool isLD2On = false;
-/* Map who matches commands and their function */
-std::map<mthl::Request::Command, std::function<mthl::Request::State(void)>> mthl::Request::fromCmdToFuncMap =
+
+namespace
+{
+  using State = mthl::Request::State;
+
+  /* Power on LED command function */
+  State powerOnLed(const mthl::Request &)
+  {
+    if (!isLD2On)
+    {
+      HAL_GPIO_TogglePin(GPIOA, GPIO_PIN_5), isLD2On = true;
+      mthl::writeWord(&huart2, "On ");
+    }
+    return State::OK;
+  } // End of 'powerOnLed' function
+
+  /* Power off LED command function */
+  State powerOffLed(const mthl::Request &)
+  {
+    if (isLD2On)
+    {
+      HAL_GPIO_TogglePin(GPIOA, GPIO_PIN_5), isLD2On = false;
+      mthl::writeWord(&huart2, "Off ");
+    }
+    return State::OK;
+  } // End of 'powerOffLed' function
+
+  /* Calibrate sensors command function */
+  State calibrate(const mthl::Request &)
+  {
+    mthl::writeWord(&huart2, "Calibration start ");
+    mthl::Controller::getInstance().calibrate();
+    for (int i = 0; i < 5; ++i)
+      mthl::writeChar(&huart6, 'C');
+    mthl::writeWord(&huart2, "Calibration finish ");
+    return State::OK;
+  } // End of 'calibrate' function
+
+  /* Posture processing on command function */
+  State postureOn(const mthl::Request &)
+  {
+    mthl::writeWord(&huart2, "Posture on ");
+    mthl::Controller::getInstance().isPostureOnSet(true);
+    return State::OK;
+  } // End of 'postureOn' function
+
+  /* Posture processing off command function */
+  State postureOff(const mthl::Request &)
+  {
+    mthl::writeWord(&huart2, "Posture off ");
+    mthl::Controller::getInstance().isPostureOnSet(false);
+    return State::OK;
+  } // End of 'postureOff' function
+
+  /* Sleep statistics output command function */
+  State sleepStats(const mthl::Request &)
+  {
+    mthl::Line<> line(&huart2);
+
+    line.putWord("Slept ").putInt(mthl::power::getSleptTime()).putWord(" of ").
+      putInt(HAL_GetTick()).putWord(" ms ");
+    return State::OK;
+  } // End of 'sleepStats' function
+
+  /* Application link statistics output command function */
+  State linkStats(const mthl::Request &)
+  {
+    mthl::RxStream *stream = mthl::RxStream::find(&huart6);
+    mthl::Line<64> line(&huart2);
+
+    line.putWord("Overruns ").putInt(stream->getOverrunsCount()).
+      putWord(" framing ").putInt(stream->getFramingErrorsCount()).
+      putWord(" noise ").putInt(stream->getNoiseErrorsCount()).
+      putWord(" frames ").putInt(mthl::Controller::getInstance().getCommandErrorsCount()).
+      putWord(" dropped ").putInt(mthl::TxQueue::find(&huart6)->getDroppedCount()).putWord(" ");
+    return State::OK;
+  } // End of 'linkStats' function
+
+  /* Posture log sending command function */
+  State logDownload(const mthl::Request &)
+  {
+    mthl::writeWord(&huart2, "Log download ");
+    mthl::Controller::getInstance().downloadLog();
+    return State::OK;
+  } // End of 'logDownload' function
+
+#ifdef MTHL_PROBES
+  /* Timing probes output command function.
+   * Line per probe: name, number of runs, minimal, maximal and mean ticks,
+   * nonzero histogram buckets as "log2:count". Statistics are cleared after output.
+   */
+  State probes(const mthl::Request &)
+  {
+    mthl::TxQueue *queue = mthl::TxQueue::find(&huart2);
+    mthl::TxQueue::Overflow policy = queue->getOverflowPolicy();
+
+    // Table is longer than queue, so output waits for sending instead of dropping
+    queue->setOverflowPolicy(mthl::TxQueue::Overflow::BLOCK);
+    for (uint32_t i = 0; i < static_cast<uint32_t>(mthl::probe::Id::COUNT); ++i)
+    {
+      auto id = static_cast<mthl::probe::Id>(i);
+      mthl::probe::Stats stats = mthl::probe::getStats(id);
+      mthl::Line<64> line(&huart2);
+
+      line.putWord(mthl::probe::getName(id)).putWord(" n ").putInt(stats.count).
+        putWord(" min ").putInt(stats.min).putWord(" max ").putInt(stats.max).
+        putWord(" mean ").putInt(stats.count == 0 ? 0 : stats.sum / stats.count);
+      for (uint32_t bucket = 0; bucket < mthl::probe::HISTOGRAM_SIZE; ++bucket)
+        if (stats.histogram[bucket] != 0)
+          line.putChar(' ').putInt(bucket).putChar(':').putInt(stats.histogram[bucket]);
+      line.putChar('\n');
+    }
+    queue->setOverflowPolicy(policy);
+    mthl::probe::reset();
+    return State::OK;
+  } // End of 'probes' function
+
+  /* Math microbenchmarks command function.
+   * CSV header and line per benchmark (see Bench.h), ticks are CPU cycles.
+   */
+  State benchmarks(const mthl::Request &)
+  {
+    mthl::TxQueue *queue = mthl::TxQueue::find(&huart2);
+    mthl::TxQueue::Overflow policy = queue->getOverflowPolicy();
+
+    queue->setOverflowPolicy(mthl::TxQueue::Overflow::BLOCK);
+    mthl::writeWord(&huart2, "name,type,iterations,ticks,per_op,unit\n");
+    for (uint32_t i = 0; i < mthl::bench::getCount(); ++i)
+    {
+      mthl::bench::Result result = mthl::bench::run(i, mthl::bench::DEVICE_ITERATIONS);
+      mthl::Line<64> line(&huart2);
+
+      line.putWord(result.name).putChar(',').putWord(result.type).putChar(',').
+        putInt(result.iterations).putChar(',').putInt(result.ticks).putChar(',').
+        putFloat(static_cast<float>(result.ticks) / result.iterations, 2).putChar(',').
+        putWord(mthl::bench::getUnit()).putChar('\n');
+    }
+    queue->setOverflowPolicy(policy);
+    return State::OK;
+  } // End of 'benchmarks' function
+#endif // MTHL_PROBES
+
+  /* Binary telemetry on command function */
+  State telemetryOn(const mthl::Request &)
+  {
+    mthl::writeWord(&huart2, "Telemetry on ");
+    mthl::Controller::getInstance().isTelemetryOnSet(true);
+    return State::OK;
+  } // End of 'telemetryOn' function
+
+  /* Binary telemetry off command function */
+  State telemetryOff(const mthl::Request &)
+  {
+    mthl::writeWord(&huart2, "Telemetry off ");
+    mthl::Controller::getInstance().isTelemetryOnSet(false);
+    return State::OK;
+  } // End of 'telemetryOff' function
+
+  /* Read little-endian 16-bit number function.
+   *
+   * Arguments:
+   *   const uint8_t *bytes -- number bytes
+   *
+   * Returns:
+   *   Number.
+   */
+  uint16_t readU16(const uint8_t *bytes)
+  {
+    return bytes[0] | bytes[1] << 8;
+  } // End of 'readU16' function
+
+  /* Report command with bad arguments function.
+   *
+   * Arguments:
+   *   None.
+   *
+   * Returns:
+   *   State of programm.
+   */
+  State badArguments()
+  {
+    mthl::writeWord(&huart2, "Bad arguments ");
+    return State::OK;
+  } // End of 'badArguments' function
+
+  /* Set posture angle bounds command function */
+  State setPostureBounds(const mthl::Request &request)
+  {
+    const uint8_t *args = request.getPayload();
+
+    if (request.getPayloadSize() != 5)
+      return badArguments();
+
+    float
+      minValue = (int16_t)readU16(args + 1) / mthl::telemetry::SPINE_ANGLE_SCALE,
+      maxValue = (int16_t)readU16(args + 3) / mthl::telemetry::SPINE_ANGLE_SCALE;
+
+    if (!mthl::Controller::getInstance().setPostureBounds(args[0], minValue, maxValue))
+      return badArguments();
+    mthl::writeWord(&huart2, "Posture bounds set ");
+    return State::OK;
+  } // End of 'setPostureBounds' function
+
+  /* Set complementary filter time constant command function */
+  State setFilterTimeConst(const mthl::Request &request)
+  {
+    if (request.getPayloadSize() != 2)
+      return badArguments();
+    mthl::Controller::getInstance().setFilterTimeConst(readU16(request.getPayload()) / 1000.0f);
+    mthl::writeWord(&huart2, "Filter set ");
+    return State::OK;
+  } // End of 'setFilterTimeConst' function
+
+  /* Set IMU-sensors sampling period command function */
+  State setSamplePeriod(const mthl::Request &request)
+  {
+    if (request.getPayloadSize() != 2 ||
+        !mthl::Controller::getInstance().setSamplePeriod(readU16(request.getPayload())))
+      return badArguments();
+    mthl::writeWord(&huart2, "Sample period set ");
+    return State::OK;
+  } // End of 'setSamplePeriod' function
+
+  /* Set telemetry subscription command function */
+  State setTelemetry(const mthl::Request &request)
+  {
+    if (request.getPayloadSize() != 1)
+      return badArguments();
+    mthl::Controller::getInstance().setTelemetryMask(request.getPayload()[0]);
+    mthl::writeWord(&huart2, "Telemetry set ");
+    return State::OK;
+  } // End of 'setTelemetry' function
+}
+
+namespace
 {
-  {Command::POWER_ON_LED,
-   []() -> State
-   {
-     if (!isLD2On)
-     {
-       HAL_GPIO_TogglePin(GPIOA, GPIO_PIN_5), isLD2On = true;
-       mthl::writeWord(&huart2, "On ");
-     }
-     return State::OK;
-   }
-  },
-
-  {Command::POWER_OFF_LED,
-   []() -> State
-   {
-     if (isLD2On)
-     {
-       HAL_GPIO_TogglePin(GPIOA, GPIO_PIN_5), isLD2On = false;
-       mthl::writeWord(&huart2, "Off ");
-     }
-     return State::OK;
-   }
-  },
-
-  {Command::CALIBRATE,
-     []() -> State
-     {
-       mthl::writeWord(&huart2, "Calibration start ");
-       mthl::Controller::getInstance().calibrate();
-       for (int i = 0; i < 5; ++i)
-         mthl::writeChar(&huart6, 'C');
-       mthl::writeWord(&huart2, "Calibration finish ");
-       return State::OK;
-     }
-   },
-
-   {Command::POSTURE_ON,
-      []() -> State
-     {
-       mthl::writeWord(&huart2, "Posture on ");
-       mthl::Controller::getInstance().isPostureOnSet(true);
-       return State::OK;
-     }
-   },
-
-   {Command::POSTURE_OFF,
-       []() -> State
-     {
-       mthl::writeWord(&huart2, "Posture off ");
-       mthl::Controller::getInstance().isPostureOnSet(false);
-       return State::OK;
-     }
-    },
-};
+  using Command = mthl::Request::Command;
+
+  /* Table who matches byte and its command function structure */
+  struct HandlerTable
+  {
+    mthl::Request::Handler values[256]; // command function of each byte (nullptr for unknown bytes)
+  }; // End of 'HandlerTable' structure
+
+  /* Build table of command functions function.
+   * Arguments: None.
+   *
+   * Returns:
+   *   Table of command functions.
+   */
+  constexpr HandlerTable makeHandlerTable()
+  {
+    HandlerTable table{};
+
+    table.values[static_cast<uint8_t>(Command::POWER_ON_LED)] = powerOnLed;
+    table.values[static_cast<uint8_t>(Command::POWER_OFF_LED)] = powerOffLed;
+    table.values[static_cast<uint8_t>(Command::CALIBRATE)] = calibrate;
+    table.values[static_cast<uint8_t>(Command::POSTURE_ON)] = postureOn;
+    table.values[static_cast<uint8_t>(Command::POSTURE_OFF)] = postureOff;
+    table.values[static_cast<uint8_t>(Command::SLEEP_STATS)] = sleepStats;
+    table.values[static_cast<uint8_t>(Command::TELEMETRY_ON)] = telemetryOn;
+    table.values[static_cast<uint8_t>(Command::TELEMETRY_OFF)] = telemetryOff;
+    table.values[static_cast<uint8_t>(Command::LINK_STATS)] = linkStats;
+    table.values[static_cast<uint8_t>(Command::LOG_DOWNLOAD)] = logDownload;
+#ifdef MTHL_PROBES
+    table.values[static_cast<uint8_t>(Command::PROBES)] = probes;
+    table.values[static_cast<uint8_t>(Command::BENCHMARKS)] = benchmarks;
+#endif // MTHL_PROBES
+    table.values[static_cast<uint8_t>(Command::SET_POSTURE_BOUNDS)] = setPostureBounds;
+    table.values[static_cast<uint8_t>(Command::SET_FILTER_TIME_CONST)] = setFilterTimeConst;
+    table.values[static_cast<uint8_t>(Command::SET_SAMPLE_PERIOD)] = setSamplePeriod;
+    table.values[static_cast<uint8_t>(Command::SET_TELEMETRY)] = setTelemetry;
+    return table;
+  } // End of 'makeHandlerTable' function
+
+  /* Table of command functions. It is built at compile time, so it is placed in flash
+   * and lookups are single reads.
+   */
+  constexpr const HandlerTable handlers = makeHandlerTable();
+}
 
 /* Request from byte constructor */
 mthl::Request::Request(uint8_t byte)
-  : command(fromByteToCmdMap[byte])
+  : byte(byte)
+{
+} // End of 'mthl::Request::Request' constructor
+
+/* Request with arguments constructor */
+mthl::Request::Request(uint8_t byte, const uint8_t *payload, uint32_t size)
+  : byte(byte), payloadSize(size < MAX_PAYLOAD_SIZE ? size : MAX_PAYLOAD_SIZE)
 {
-  // There we  can check byte and throw exception for example
+  for (uint32_t i = 0; i < payloadSize; ++i)
+    this->payload[i] = payload[i];
 } // End of 'mthl::Request::Request' constructor
 
+/* Check if byte is known command function */
+bool mthl::Request::isCommand(uint8_t byte)
+{
+  return handlers.values[byte] != nullptr;
+} // End of 'mthl::Request::isCommand' function
+
 /* Doing command from request function */
 mthl::Request::State mthl::Request::doCommand() const
 {
-  return fromCmdToFuncMap[command]();
+  Handler handler = handlers.values[byte];
+
+  if (handler == nullptr)
+    return State::OK;
+  return handler(*this);
 } // End of 'mthl::Request::doCommand' function
+
+/* Command arguments getter */
+const uint8_t * mthl::Request::getPayload() const
+{
+  return payload;
+} // End of 'mthl::Request::getPayload' function
+
+/* Command arguments size getter */
+uint32_t mthl::Request::getPayloadSize() const
+{
+  return payloadSize;
+} // End of 'mthl::Request::getPayloadSize' function
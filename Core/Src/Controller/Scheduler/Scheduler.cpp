@@ -0,0 +1,105 @@
+/******************************
+ * File name   : Scheduler.cpp
+ * Purpose     : Mithrill project.
+ *               Controller module.
+ *               Periodic cooperative tasks scheduler class implementation.
+ * Author      : Filippov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include "Controller/Scheduler/Scheduler.h"
+
+/* Add periodic task function */
+bool mthl::Scheduler::addTask(BaseFunc *func, uint32_t period, uint32_t deadline, uint32_t delay)
+{
+  if (func == nullptr || period == 0 || tasksCount == MAX_TASKS)
+    return false;
+
+  Task task;
+
+  task.func = func;
+  task.period = period;
+  task.deadline = deadline == 0 ? period : deadline;
+  task.release = HAL_GetTick() + delay;
+  insert(task);
+
+  return true;
+} // End of 'mthl::Scheduler::addTask' function
+
+/* Run all released tasks function */
+uint32_t mthl::Scheduler::run()
+{
+  uint32_t runCount = 0, now = HAL_GetTick();
+
+  // Each call runs every task at most once, so late tasks can't stall main loop
+  while (tasksCount != 0 && runCount < tasksCount && isReached(tasks[0].release, now))
+  {
+    Task task = tasks[0];
+
+    for (std::size_t i = 1; i < tasksCount; ++i)
+      tasks[i - 1] = tasks[i];
+    --tasksCount;
+
+    task.func->doFunction();
+    ++runCount;
+
+    uint32_t end = HAL_GetTick();
+
+    if (end - task.release > task.deadline)
+      ++missesCount;
+
+    // Releases whose deadlines are already passed are skipped and counted as misses
+    task.release += task.period;
+    if (isReached(task.release, end) && end - task.release > task.deadline)
+    {
+      uint32_t skipped = (end - task.release - task.deadline - 1) / task.period + 1;
+
+      task.release += skipped * task.period;
+      missesCount += skipped;
+    }
+    insert(task);
+  }
+
+  return runCount;
+} // End of 'mthl::Scheduler::run' function
+
+/* Time to next release getter */
+uint32_t mthl::Scheduler::getTimeToNext() const
+{
+  if (tasksCount == 0)
+    return HAL_MAX_DELAY;
+
+  uint32_t now = HAL_GetTick();
+
+  if (isReached(tasks[0].release, now))
+    return 0;
+  return tasks[0].release - now;
+} // End of 'mthl::Scheduler::getTimeToNext' function
+
+/* Number of missed deadlines getter */
+uint32_t mthl::Scheduler::getMissesCount() const
+{
+  return missesCount;
+} // End of 'mthl::Scheduler::getMissesCount' function
+
+/* Check if time is reached function */
+bool mthl::Scheduler::isReached(uint32_t time, uint32_t now)
+{
+  return static_cast<int32_t>(now - time) >= 0;
+} // End of 'mthl::Scheduler::isReached' function
+
+/* Put task to its place by release time function */
+void mthl::Scheduler::insert(const Task &task)
+{
+  std::size_t i = tasksCount;
+
+  // Tasks released later are shifted
+  while (i > 0 && !isReached(tasks[i - 1].release, task.release))
+  {
+    tasks[i] = tasks[i - 1];
+    --i;
+  }
+  tasks[i] = task;
+  ++tasksCount;
+} // End of 'mthl::Scheduler::insert' function
@@ -5,20 +5,146 @@
  *               
  * Author      : Tarasov Denis
  * Create date : 31.03.2020
- * Last change : 01.04.2020
+ * Last change : 18.10.2026
  ******************************/
 
 #include "Filters/Filters.h"
+#include "Math/fastmath.h"
+#include "Probe.h"
+
+namespace
+{
+  using mthl::math::fastAtan2;
+  using mthl::math::fastSqrt;
+
+  const float
+    DEG_TO_RAD = 3.14159265f / 180, // Degrees to radians scale
+    RAD_TO_DEG = 180 / 3.14159265f; // Radians to degrees scale
+
+  /* Angles which accelerometer gives for gravity vector function.
+   * Arguments:
+   *   float x, y, z -- gravity vector
+   *
+   * Returns:
+   *   Angles in degrees.
+   */
+  mthl::math::quater<float> gravityToAngles(float x, float y, float z)
+  {
+    return mthl::math::quater<float>(
+        fastAtan2(x, fastSqrt(y * y + z * z)),
+        fastAtan2(y, fastSqrt(x * x + z * z)),
+        fastAtan2(fastSqrt(x * x + y * y), z)
+        ) * RAD_TO_DEG;
+  }
+
+  /* Gravity vector direction in sensor frame for orientation function.
+   * Arguments:
+   *   quater q -- orientation quaternion
+   *
+   * Returns:
+   *   Gravity vector direction.
+   */
+  mthl::math::vec<float> gravityOf(const mthl::math::quater<float> &q)
+  {
+    return mthl::math::vec<float>(2 * (q[1] * q[3] - q[0] * q[2]), 2 * (q[0] * q[1] + q[2] * q[3]),
+        q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3]);
+  }
+}
 
 /* Complementary filter function */
 mthl::math::quater<float> mthl::filters::complementary(mthl::math::quater<float> prev,
     mthl::math::quater<float> gyro, mthl::math::quater<float> accel, float dtime, float delta)
+{
+  MTHL_PROBE(COMPLEMENTARY);
+  return (prev + gyro * dtime) * (1 - delta) + gravityToAngles(accel[0], accel[1], accel[2]) * delta;
+}
+
+/* Complementary filter delta evaluation function */
+float mthl::filters::complementaryDelta(float dtime, float timeConst)
+{
+  if (dtime + timeConst <= 0)
+    return 1;
+  return dtime / (dtime + timeConst);
+}
+
+/* Madgwick filter function */
+mthl::math::quater<float> mthl::filters::madgwick(mthl::math::quater<float> q,
+    mthl::math::quater<float> gyro, mthl::math::quater<float> accel, float dtime, float beta)
 {
   using mthl::math::quater;
 
-  return (prev + gyro * dtime) * (1 - delta) + quater<float>(
-      atan2(accel[0], sqrt(accel[1] * accel[1] + accel[2] * accel[2])),
-      atan2(accel[1], sqrt(accel[0] * accel[0] + accel[2] * accel[2])),
-      atan2(sqrt(accel[0] * accel[0] + accel[1] * accel[1]), accel[2])
-      ) * delta * 180 / 3.14159265;
+  // Rate of change of orientation from gyroscope
+  quater<float> qDot = q * quater<float>(0, gyro[0], gyro[1], gyro[2]) * (DEG_TO_RAD / 2);
+  float norm = fastSqrt(accel[0] * accel[0] + accel[1] * accel[1] + accel[2] * accel[2]);
+
+  // Accelerometer data is used only if it is valid
+  if (norm > 0)
+  {
+    float
+      ax = accel[0] / norm, ay = accel[1] / norm, az = accel[2] / norm,
+      q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+    // Difference between estimated and measured gravity direction
+    float
+      f0 = 2 * (q1 * q3 - q0 * q2) - ax,
+      f1 = 2 * (q0 * q1 + q2 * q3) - ay,
+      f2 = 2 * (0.5f - q1 * q1 - q2 * q2) - az;
+    // Gradient of the difference (Jacobian transposed multiplied by difference)
+    quater<float> step(
+        -2 * q2 * f0 + 2 * q1 * f1,
+        2 * q3 * f0 + 2 * q0 * f1 - 4 * q1 * f2,
+        -2 * q0 * f0 + 2 * q3 * f1 - 4 * q2 * f2,
+        2 * q1 * f0 + 2 * q2 * f1);
+
+    if (step.lengthSquared() > 0)
+      qDot -= step.normalize() * beta;
+  }
+
+  return (q + qDot * dtime).normalize();
+}
+
+/* Mahony filter function */
+mthl::math::quater<float> mthl::filters::mahony(mthl::math::quater<float> q,
+    mthl::math::quater<float> gyro, mthl::math::quater<float> accel, float dtime, float kp, float ki,
+    mthl::math::vec<float> &integral)
+{
+  using mthl::math::quater;
+  using mthl::math::vec;
+
+  vec<float>
+    g = vec<float>(gyro[0], gyro[1], gyro[2]) * DEG_TO_RAD,
+    a(accel[0], accel[1], accel[2]);
+
+  // Accelerometer data is used only if it is valid
+  if (a.lengthSquared() > 0)
+  {
+    // Error is rotation between measured and estimated gravity direction
+    vec<float> error = a.normalize() % gravityOf(q);
+
+    integral += error * (ki * dtime);
+    g += error * kp + integral;
+  }
+
+  return (q + q * quater<float>(0, g) * (dtime / 2)).normalize();
+}
+
+/* Orientation from accelerometer data evaluation function */
+mthl::math::quater<float> mthl::filters::orientationFromAccel(mthl::math::quater<float> accel)
+{
+  float
+    roll = fastAtan2(accel[1], accel[2]) / 2,
+    pitch = fastAtan2(-accel[0], fastSqrt(accel[1] * accel[1] + accel[2] * accel[2])) / 2,
+    sinRoll, cosRoll, sinPitch, cosPitch;
+
+  mthl::math::fastSinCos(roll, sinRoll, cosRoll);
+  mthl::math::fastSinCos(pitch, sinPitch, cosPitch);
+  return mthl::math::quater<float>(cosRoll * cosPitch, sinRoll * cosPitch, cosRoll * sinPitch,
+      -sinRoll * sinPitch);
+}
+
+/* Orientation quaternion to angles conversion function */
+mthl::math::quater<float> mthl::filters::orientationToAngles(mthl::math::quater<float> q)
+{
+  mthl::math::vec<float> g = gravityOf(q);
+
+  return gravityToAngles(g[0], g[1], g[2]);
 }
@@ -0,0 +1,126 @@
+/******************************
+ * File name   : Power.cpp
+ * Purpose     : Mithrill project.
+ *               Tickless low power idle
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include "Power.h"
+
+namespace
+{
+  const uint32_t
+    MIN_SLEEP_CYCLES = 64, // Minimal number of SysTick cycles worth sleeping
+    MIN_RELOAD_CYCLES = 4; // Minimal SysTick reload after wake up
+
+  uint32_t
+    sleptTime = 0,   // Time spent in sleep (milliseconds)
+    sleptCycles = 0; // Time spent in sleep less than millisecond (SysTick cycles)
+
+  /* Account time spent in sleep function.
+   * Arguments:
+   *   uint32_t cycles -- number of SysTick cycles spent in sleep
+   *   uint32_t tickCycles -- number of SysTick cycles in millisecond
+   *
+   * Returns:
+   *   None.
+   */
+  void addSleptCycles(uint32_t cycles, uint32_t tickCycles)
+  {
+    sleptCycles += cycles;
+    sleptTime += sleptCycles / tickCycles;
+    sleptCycles %= tickCycles;
+  }
+}
+
+/* Sleep until time passes or any interrupt comes function */
+void mthl::power::sleep(uint32_t time)
+{
+  uint32_t
+    tickCycles = SysTick->LOAD + 1,
+    // Cycles left to next tick
+    toTick = SysTick->VAL + 1,
+    maxTime = (SysTick_LOAD_RELOAD_Msk - toTick) / tickCycles + 1;
+
+  if (time == 0 || toTick < MIN_SLEEP_CYCLES)
+    return;
+  if (time > maxTime)
+    time = maxTime;
+
+  // SysTick fires at the tick which is 'time' milliseconds later
+  uint32_t sleepCycles = toTick + (time - 1) * tickCycles;
+
+  SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+  SysTick->LOAD = sleepCycles - 1;
+  SysTick->VAL = 0;
+  SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+  // Sample times stay right: DWT cycle counter runs in sleep (see 'timer::init')
+  __DSB();
+  __WFI();
+  __ISB();
+
+  // Count flag is cleared by reading, so control register is read once
+  uint32_t ctrl = SysTick->CTRL;
+
+  SysTick->CTRL = ctrl & ~SysTick_CTRL_ENABLE_Msk;
+
+  if ((ctrl & SysTick_CTRL_COUNTFLAG_Msk) != 0)
+  {
+    // Whole time passed. Pending SysTick interrupt will count last tick itself
+    uwTick += (time - 1) * uwTickFreq;
+    addSleptCycles(sleepCycles, tickCycles);
+    SysTick->LOAD = tickCycles - 1;
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    return;
+  }
+
+  // Woken by other interrupt: count passed ticks and wait for the rest of current one
+  uint32_t
+    passed = sleepCycles - 1 - SysTick->VAL,
+    passedTicks = passed < toTick ? 0 : (passed - toTick) / tickCycles + 1,
+    rest = toTick + passedTicks * tickCycles - passed;
+
+  // Too short reload can't be set, so tick which is about to come is counted now
+  if (rest < MIN_RELOAD_CYCLES)
+  {
+    ++passedTicks;
+    rest += tickCycles;
+  }
+  uwTick += passedTicks * uwTickFreq;
+  addSleptCycles(passed, tickCycles);
+  SysTick->LOAD = rest - 1;
+  SysTick->VAL = 0;
+  SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+  // New reload value is used starting from the next tick
+  SysTick->LOAD = tickCycles - 1;
+} // End of 'mthl::power::sleep' function
+
+/* Time spent in sleep getter */
+uint32_t mthl::power::getSleptTime()
+{
+  return sleptTime;
+} // End of 'mthl::power::getSleptTime' function
+
+/* Delay function (overrides HAL weak one).
+ * CPU sleeps between ticks instead of polling tick counter.
+ * Arguments:
+ *   uint32_t Delay -- time to wait (milliseconds)
+ *
+ * Returns:
+ *   None.
+ */
+void HAL_Delay(uint32_t Delay)
+{
+  uint32_t tickstart = HAL_GetTick();
+
+  // Add a freq to guarantee minimum wait, as HAL does
+  if (Delay < HAL_MAX_DELAY)
+    Delay += (uint32_t)uwTickFreq;
+
+  while (HAL_GetTick() - tickstart < Delay)
+    __WFI();
+} // End of 'HAL_Delay' function
@@ -0,0 +1,85 @@
+/******************************
+ * File name   : Probe.cpp
+ * Purpose     : Mithrill project.
+ *               Hot path timing probes
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include "Probe.h"
+
+#ifdef MTHL_PROBES
+
+#include "stm32f4xx_hal.h"
+
+namespace
+{
+  /* Statistics of all probes */
+  mthl::probe::Stats stats[static_cast<uint32_t>(mthl::probe::Id::COUNT)];
+
+  /* Names of probes in order of identifiers */
+  const char * const NAMES[] =
+  {
+    "imu_update",
+    "complementary",
+    "abs_angles",
+    "spine_angle",
+    "posture",
+    "uart_write"
+  };
+
+  static_assert(sizeof(NAMES) / sizeof(NAMES[0]) == static_cast<uint32_t>(mthl::probe::Id::COUNT),
+      "Every probe must have name");
+}
+
+/* Add probe run function */
+void mthl::probe::record(Id id, uint32_t ticks)
+{
+  // Probes of interrupts can come while probe of main loop is recorded
+  uint32_t primask = __get_PRIMASK();
+  Stats &s = stats[static_cast<uint32_t>(id)];
+  uint32_t bucket = ticks == 0 ? 0 : 32 - __builtin_clz(ticks);
+
+  __disable_irq();
+  if (s.count == 0)
+    s.min = UINT32_MAX;
+  ++s.count;
+  s.sum += ticks;
+  if (ticks < s.min)
+    s.min = ticks;
+  if (ticks > s.max)
+    s.max = ticks;
+  ++s.histogram[bucket < HISTOGRAM_SIZE ? bucket : HISTOGRAM_SIZE - 1];
+  __set_PRIMASK(primask);
+} // End of 'mthl::probe::record' function
+
+/* Probe statistics getter */
+mthl::probe::Stats mthl::probe::getStats(Id id)
+{
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  Stats s = stats[static_cast<uint32_t>(id)];
+  __set_PRIMASK(primask);
+  return s;
+} // End of 'mthl::probe::getStats' function
+
+/* Probe name getter */
+const char * mthl::probe::getName(Id id)
+{
+  return NAMES[static_cast<uint32_t>(id)];
+} // End of 'mthl::probe::getName' function
+
+/* Clear statistics of all probes function */
+void mthl::probe::reset()
+{
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  for (auto &s : stats)
+    s = {};
+  __set_PRIMASK(primask);
+} // End of 'mthl::probe::reset' function
+
+#endif // MTHL_PROBES
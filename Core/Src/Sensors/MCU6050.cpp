@@ -5,13 +5,18 @@
  * Author      : Tarasov Denis
  *               Filippov Denis
  * Create date : 02.03.2020
- * Last change : 26.05.2020
+ * Last change : 18.10.2026
  ******************************/
 
 #include <stdexcept>
 
 #include "Sensors/MCU6050.h"
 #include "Filters/Filters.h"
+#include "Timer.h"
+#include "Probe.h"
+
+/* Buffer for FIFO reading */
+uint8_t mthl::MCU6050::fifoBuffer[FIFO_SIZE];
 
 /* 'MCU6050' class constructor */
 mthl::MCU6050::MCU6050(I2C_HandleTypeDef *handle, uint8_t addr) : i2c_handle(handle),
@@ -23,7 +28,8 @@ mthl::MCU6050::MCU6050(I2C_HandleTypeDef *handle, uint8_t addr) : i2c_handle(han
   // Try to get signature
   HAL_I2C_Mem_Read(i2c_handle, addres, WHO_AM_I_REG, 1, &check, 1, 1000);
 
-  if (check == SIGNATURE)  // Check device signature
+  isOnline = check == SIGNATURE;
+  if (isOnline)  // Check device signature
   {
     //char mes[] = "Failed to initialize module";
 
@@ -43,13 +49,16 @@ mthl::MCU6050::MCU6050(I2C_HandleTypeDef *handle, uint8_t addr) : i2c_handle(han
     Data = 0x00;
     if (HAL_I2C_Mem_Write(i2c_handle, addres, GYRO_CONFIG_REG, 1, &Data, 1, 1000) != HAL_OK)
       ;//throw std::logic_error(mes);
-    // Calibrate gyroscope
-    calibrate(100);
   }
   else
     ;//throw std::logic_error("Failed to connect to device. Probably device is different from the specified");
 } // End of 'MCU6050' constructor
 
+/* 'MCU6050' class constructor of sensor without device */
+mthl::MCU6050::MCU6050() : i2c_handle(nullptr), addres{0}, angles{0}, calibratedAngles{0}
+{
+} // End of 'MCU6050' constructor
+
 /* Read accelerometer data function */
 void mthl::MCU6050::readAccel(math::quater<float> &v)
 {
@@ -82,29 +91,310 @@ void mthl::MCU6050::readGyro(math::quater<float> &v)
   v -= calibratedGyro;
 } // End of 'readGyro' function
 
+/* Read accelerometer, temperature and gyroscope data function */
+void mthl::MCU6050::readMotion(Sample &s)
+{
+  // Registers from ACCEL_XOUT_H_REG to GYRO_ZOUT_L_REG are contiguous, so one transaction is enough
+  uint8_t buffer[MOTION_DATA_SIZE];
+  if (HAL_I2C_Mem_Read(i2c_handle, addres, ACCEL_XOUT_H_REG, 1, buffer, MOTION_DATA_SIZE, 1000) != HAL_OK)
+    ;//throw std::logic_error("Lost connection with module");
+  s.time = timer::getCycles();
+
+  decodeMotion(buffer, s);
+} // End of 'readMotion' function
+
+/* Start reading of motion data with DMA function */
+HAL_StatusTypeDef mthl::MCU6050::startMotionRead()
+{
+  motionTime = timer::getCycles();
+
+  return HAL_I2C_Mem_Read_DMA(i2c_handle, addres, ACCEL_XOUT_H_REG, 1, motionBuffer, MOTION_DATA_SIZE);
+} // End of 'startMotionRead' function
+
+/* Finish reading of motion data with DMA function */
+void mthl::MCU6050::finishMotionRead()
+{
+  putMotion(motionBuffer, motionTime);
+} // End of 'finishMotionRead' function
+
+/* Put raw motion data read from device function */
+void mthl::MCU6050::putMotion(const uint8_t *buffer, uint32_t time)
+{
+  pendingSample.time = time;
+  decodeMotion(buffer, pendingSample);
+  isSamplePending = true;
+} // End of 'putMotion' function
+
+/* Enable data ready interrupt function */
+bool mthl::MCU6050::enableDataReadyInt()
+{
+  uint8_t Data = 0;
+
+  // Set low pass filter, so samples rate can be reduced without aliasing
+  Data = CONFIG_DLPF_44HZ;
+  if (HAL_I2C_Mem_Write(i2c_handle, addres, CONFIG_REG, 1, &Data, 1, 1000) != HAL_OK)
+    return false;
+  // Set rate of new samples
+  Data = DATA_READY_RATE_DIV;
+  if (HAL_I2C_Mem_Write(i2c_handle, addres, SMPLRT_DIV_REG, 1, &Data, 1, 1000) != HAL_OK)
+    return false;
+  // Pulse on INT pin for each new sample
+  Data = INT_PIN_CFG_PULSE;
+  if (HAL_I2C_Mem_Write(i2c_handle, addres, INT_PIN_CFG_REG, 1, &Data, 1, 1000) != HAL_OK)
+    return false;
+  Data = INT_ENABLE_DATA_RDY;
+  if (HAL_I2C_Mem_Write(i2c_handle, addres, INT_ENABLE_REG, 1, &Data, 1, 1000) != HAL_OK)
+    return false;
+
+  return true;
+} // End of 'enableDataReadyInt' function
+
+/* Enable FIFO mode function */
+bool mthl::MCU6050::enableFifo()
+{
+  uint8_t Data = 0;
+
+  // Set low pass filter, so samples rate can be reduced without aliasing
+  Data = CONFIG_DLPF_44HZ;
+  if (HAL_I2C_Mem_Write(i2c_handle, addres, CONFIG_REG, 1, &Data, 1, 1000) != HAL_OK)
+    return false;
+  // Set FIFO samples rate
+  Data = FIFO_RATE_DIV;
+  if (HAL_I2C_Mem_Write(i2c_handle, addres, SMPLRT_DIV_REG, 1, &Data, 1, 1000) != HAL_OK)
+    return false;
+  // Put accelerometer and gyroscope data to FIFO
+  Data = FIFO_EN_ACCEL_GYRO;
+  if (HAL_I2C_Mem_Write(i2c_handle, addres, FIFO_EN_REG, 1, &Data, 1, 1000) != HAL_OK)
+    return false;
+  if (resetFifo() != HAL_OK)
+    return false;
+
+  isFifoOn = true;
+  isSamplePending = false;
+  return true;
+} // End of 'enableFifo' function
+
+/* Disable FIFO mode function */
+void mthl::MCU6050::disableFifo()
+{
+  uint8_t Data = 0;
+
+  isFifoOn = false;
+  // Stop FIFO
+  Data = 0x00;
+  HAL_I2C_Mem_Write(i2c_handle, addres, FIFO_EN_REG, 1, &Data, 1, 1000);
+  HAL_I2C_Mem_Write(i2c_handle, addres, USER_CTRL_REG, 1, &Data, 1, 1000);
+  // Restore low pass filter and DATA RATE of 1KHz
+  HAL_I2C_Mem_Write(i2c_handle, addres, CONFIG_REG, 1, &Data, 1, 1000);
+  Data = 0x07;
+  HAL_I2C_Mem_Write(i2c_handle, addres, SMPLRT_DIV_REG, 1, &Data, 1, 1000);
+} // End of 'disableFifo' function
+
+/* Process all samples stored in FIFO function */
+uint32_t mthl::MCU6050::drainFifo()
+{
+  uint8_t buffer[2];
+
+  // Order of samples is lost after overflow, so FIFO is restarted
+  if (HAL_I2C_Mem_Read(i2c_handle, addres, INT_STATUS_REG, 1, buffer, 1, 1000) != HAL_OK)
+    return 0;
+  if (buffer[0] & INT_STATUS_FIFO_OFLOW)
+  {
+    fifoOverflowsCount++;
+    resetFifo();
+    return 0;
+  }
+
+  if (HAL_I2C_Mem_Read(i2c_handle, addres, FIFO_COUNTH_REG, 1, buffer, 2, 1000) != HAL_OK)
+    return 0;
+
+  // Only whole samples are read, the rest stays in FIFO
+  uint32_t count = (uint16_t)(buffer[0] << 8 | buffer[1]) / FIFO_FRAME_SIZE;
+
+  if (count == 0)
+    return 0;
+  if (HAL_I2C_Mem_Read(i2c_handle, addres, FIFO_R_W_REG, 1, fifoBuffer, count * FIFO_FRAME_SIZE,
+      1000) != HAL_OK)
+  {
+    // Position of samples in FIFO is unknown after failed reading
+    resetFifo();
+    return 0;
+  }
+
+  Sample sample;
+
+  // Samples in FIFO are measured with device clock, so time between them is known exactly
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    decodeFifoFrame(fifoBuffer + i * FIFO_FRAME_SIZE, sample);
+    filterSample(sample, FIFO_SAMPLE_PERIOD);
+  }
+  prevSampleTime = timer::getCycles();
+
+  return count;
+} // End of 'drainFifo' function
+
+/* Number of FIFO overflows getter */
+uint32_t mthl::MCU6050::getFifoOverflowsCount() const
+{
+  return fifoOverflowsCount;
+} // End of 'getFifoOverflowsCount' function
+
+/* Set orientation filter function */
+void mthl::MCU6050::setFilter(filters::Type type)
+{
+  filterType = type;
+  isOrientationSet = false;
+} // End of 'setFilter' function
+
+/* Set complementary filter time constant function */
+void mthl::MCU6050::setFilterTimeConst(float timeConst)
+{
+  filterTimeConst = timeConst;
+} // End of 'setFilterTimeConst' function
+
+/* Set sampling period function */
+bool mthl::MCU6050::setSamplePeriod(uint32_t period)
+{
+  if (isFifoOn || period == 0 || period > 256)
+    return false;
+
+  uint8_t Data = period - 1;
+
+  return HAL_I2C_Mem_Write(i2c_handle, addres, SMPLRT_DIV_REG, 1, &Data, 1, 1000) == HAL_OK;
+} // End of 'setSamplePeriod' function
+
+/* Pass sample through orientation filter function */
+void mthl::MCU6050::filterSample(const Sample &s, float dtime)
+{
+  lastSample = s;
+  if (filterType == filters::Type::COMPLEMENTARY)
+  {
+    angles = mthl::filters::complementary(angles, s.gyro, s.accel, dtime,
+        mthl::filters::complementaryDelta(dtime, filterTimeConst));
+    return;
+  }
+
+  // Quaternion filters start from orientation given by accelerometer
+  if (!isOrientationSet)
+  {
+    orientation = mthl::filters::orientationFromAccel(s.accel);
+    mahonyIntegral = math::vec<float>::zero();
+    isOrientationSet = true;
+  }
+  else if (filterType == filters::Type::MADGWICK)
+    orientation = mthl::filters::madgwick(orientation, s.gyro, s.accel, dtime, MADGWICK_BETA);
+  else
+    orientation = mthl::filters::mahony(orientation, s.gyro, s.accel, dtime, MAHONY_KP, MAHONY_KI,
+        mahonyIntegral);
+
+  angles = mthl::filters::orientationToAngles(orientation);
+} // End of 'filterSample' function
+
+/* Evaluate time passed since previous filtered sample function */
+float mthl::MCU6050::getSamplePeriod(uint32_t time)
+{
+  float dtime = timer::getElapsed(prevSampleTime, time);
+
+  prevSampleTime = time;
+  return dtime > MAX_SAMPLE_PERIOD ? MAX_SAMPLE_PERIOD : dtime;
+} // End of 'getSamplePeriod' function
+
+/* Reset device FIFO function */
+HAL_StatusTypeDef mthl::MCU6050::resetFifo()
+{
+  uint8_t Data = USER_CTRL_FIFO_RESET;
+  HAL_StatusTypeDef status = HAL_I2C_Mem_Write(i2c_handle, addres, USER_CTRL_REG, 1, &Data, 1, 1000);
+
+  if (status != HAL_OK)
+    return status;
+
+  Data = USER_CTRL_FIFO_EN;
+  return HAL_I2C_Mem_Write(i2c_handle, addres, USER_CTRL_REG, 1, &Data, 1, 1000);
+} // End of 'resetFifo' function
+
+/* I2C handler getter */
+I2C_HandleTypeDef * mthl::MCU6050::getHandle() const
+{
+  return i2c_handle;
+} // End of 'getHandle' function
+
+/* Convert raw motion data to sample function */
+void mthl::MCU6050::decodeMotion(const uint8_t *buffer, Sample &s) const
+{
+  s.accel[0] = (int16_t)(buffer[0] << 8 | buffer[1]) / ACC_SCALE;
+  s.accel[1] = (int16_t)(buffer[2] << 8 | buffer[3]) / ACC_SCALE;
+  s.accel[2] = (int16_t)(buffer[4] << 8 | buffer[5]) / ACC_SCALE;
+
+  s.temp = (int16_t)(buffer[6] << 8 | buffer[7]) / TEMP_SCALE + TEMP_OFFSET;
+
+  s.gyro[0] = (int16_t)(buffer[8] << 8 | buffer[9]) / GYRO_SCALE;
+  s.gyro[1] = (int16_t)(buffer[10] << 8 | buffer[11]) / GYRO_SCALE;
+  s.gyro[2] = (int16_t)(buffer[12] << 8 | buffer[13]) / GYRO_SCALE;
+
+  s.gyro -= calibratedGyro;
+} // End of 'decodeMotion' function
+
+/* Convert FIFO frame to sample function */
+void mthl::MCU6050::decodeFifoFrame(const uint8_t *buffer, Sample &s) const
+{
+  s.accel[0] = (int16_t)(buffer[0] << 8 | buffer[1]) / ACC_SCALE;
+  s.accel[1] = (int16_t)(buffer[2] << 8 | buffer[3]) / ACC_SCALE;
+  s.accel[2] = (int16_t)(buffer[4] << 8 | buffer[5]) / ACC_SCALE;
+
+  s.gyro[0] = (int16_t)(buffer[6] << 8 | buffer[7]) / GYRO_SCALE;
+  s.gyro[1] = (int16_t)(buffer[8] << 8 | buffer[9]) / GYRO_SCALE;
+  s.gyro[2] = (int16_t)(buffer[10] << 8 | buffer[11]) / GYRO_SCALE;
+
+  s.gyro -= calibratedGyro;
+} // End of 'decodeFifoFrame' function
+
 /* Evaluate angles of deflection */
 mthl::math::quater<float> mthl::MCU6050::getAnglesOfDefl()
 {
   return getAbsAngles() - calibratedAngles;
 } // End of 'getAnglesOfDefl' function
 
-/* Evaluate absolute angles */
-mthl::math::quater<float> mthl::MCU6050::getAbsAngles()
+/* Filter data read since previous update function */
+void mthl::MCU6050::update()
 {
-  mthl::math::quater<float> gyro, accel;
+  MTHL_PROBE(IMU_UPDATE);
+  if (isFifoOn)
+  {
+    drainFifo();
+    return;
+  }
 
-  readGyro(gyro);
-  readAccel(accel);
+  if (!isSamplePending)
+    return;
+  isSamplePending = false;
+  filterSample(pendingSample, getSamplePeriod(pendingSample.time));
+} // End of 'update' function
 
-  return angles = mthl::filters::complementary(angles, gyro, accel, 0.04, 0.2);
+/* Evaluate absolute angles */
+mthl::math::quater<float> mthl::MCU6050::getAbsAngles()
+{
+  MTHL_PROBE(ABS_ANGLES);
+  return angles;
 } // End of 'getAbsAngles' function
 
+/* Last filtered sample getter */
+mthl::IMU::Sample mthl::MCU6050::getLastSample()
+{
+  return lastSample;
+} // End of 'getLastSample' function
+
 /* Calibrate device */
-void mthl::MCU6050::calibrate(int32_t iterations)
+bool mthl::MCU6050::calibrate(int32_t iterations)
 {
+  if (!isOnline)
+    return false;
+
   // Gyroscope calibration
   math::quater<float> gData;
 
+  // Bias is evaluated again, not added to previous one
+  calibratedGyro = math::quater<float>(0);
   for (int32_t i = 0; i < iterations; ++i)
   {
     readGyroRaw(gData);
@@ -115,19 +405,51 @@ void mthl::MCU6050::calibrate(int32_t iterations)
   calibratedGyro /= (float)iterations;
 
   // Angles calibration
-  mthl::math::quater<float> gyro(0), accel;
+  Sample sample;
 
-  readAccel(accel);
+  readMotion(sample);
 
-  calibratedAngles = mthl::filters::complementary(calibratedAngles, gyro, accel, 0, 1.0);
+  calibratedAngles = mthl::filters::complementary(calibratedAngles, math::quater<float>(0),
+      sample.accel, 0, 1.0f);
+  prevSampleTime = sample.time;
 
   for (int i = 0; i < iterations; ++i)
   {
-    readGyro(gyro);
-    readAccel(accel);
-    calibratedAngles = mthl::filters::complementary(calibratedAngles, gyro, accel, 0.001, 0.04);
+    readMotion(sample);
+    calibratedAngles = mthl::filters::complementary(calibratedAngles, sample.gyro, sample.accel,
+        getSamplePeriod(sample.time), 0.04f);
     HAL_Delay(1);
   }
 
   angles = calibratedAngles;
+  // Quaternion filters start from new position
+  isOrientationSet = false;
+  // Samples read before calibration are not valid anymore
+  isSamplePending = false;
+  if (isFifoOn)
+    resetFifo();
+  return true;
 } // End of 'calibrate' function
+
+/* Sensor identity getter */
+uint32_t mthl::MCU6050::getId()
+{
+  return (reinterpret_cast<uintptr_t>(i2c_handle->Instance) & 0xFFFF) << 8 | addres;
+} // End of 'getId' function
+
+/* Calibration data getter */
+mthl::IMU::Calibration mthl::MCU6050::getCalibration()
+{
+  return {calibratedGyro, calibratedAngles};
+} // End of 'getCalibration' function
+
+/* Calibration data setter */
+void mthl::MCU6050::setCalibration(const Calibration &calibration)
+{
+  calibratedGyro = calibration.gyro;
+  calibratedAngles = calibration.angles;
+  angles = calibratedAngles;
+  // Quaternion filters start from new position
+  isOrientationSet = false;
+  isSamplePending = false;
+} // End of 'setCalibration' function
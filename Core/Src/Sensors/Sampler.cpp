@@ -0,0 +1,255 @@
+/******************************
+ * File name   : Sampler.cpp
+ * Purpose     : Mithrill project.
+ *               Non-blocking DMA sampling engine for MCU6050 sensors
+ * Author      : Tarasov Denis
+ *               Filippov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include "Sensors/Sampler.h"
+
+/* Add sensor to sampling function */
+bool mthl::Sampler::addSensor(MCU6050 *sensor, uint16_t dataReadyPin)
+{
+  if (isBusy())
+    return false;
+
+  Bus *bus = findBus(sensor->getHandle());
+
+  // Take new bus for sensor
+  if (bus == nullptr)
+  {
+    if (busesCount == MAX_BUSES)
+      return false;
+    bus = &buses[busesCount++];
+    bus->handle = sensor->getHandle();
+  }
+
+  if (bus->count == MAX_BUS_SENSORS)
+    return false;
+  bus->sensors[bus->count++] = sensor;
+  triggerPins |= dataReadyPin;
+
+  return true;
+} // End of 'mthl::Sampler::addSensor' function
+
+/* Start reading of new sample set function */
+bool mthl::Sampler::start()
+{
+  bool isStarted = false;
+  // Set is decided and marked atomically, transfers are started with interrupts enabled
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  if (busesCount != 0 && !isPaused && !isBusy() && !isSetReady)
+  {
+    uint16_t silentPins = triggerPins & ~readyPins;
+
+    if (silentPins != 0)
+    {
+      // Sensors of silent pins are still read, but set is not waiting for them
+      uint32_t time = HAL_GetTick();
+
+      if (!isWaiting)
+      {
+        isWaiting = true;
+        waitStartTime = time;
+      }
+      else if (time - waitStartTime >= DATA_READY_TIMEOUT)
+      {
+        triggerPins &= ~silentPins;
+        silentPinsCount += __builtin_popcount(silentPins);
+        silentPins = 0;
+      }
+    }
+    if (silentPins == 0)
+    {
+      isWaiting = false;
+      readyPins = 0;
+      markSet();
+      isStarted = true;
+    }
+  }
+  __set_PRIMASK(primask);
+
+  service();
+  return isStarted;
+} // End of 'mthl::Sampler::start' function
+
+/* Start transfers requested by interrupts function */
+void mthl::Sampler::service()
+{
+  for (std::size_t i = 0; i < busesCount; ++i)
+  {
+    uint32_t bit = 1 << i;
+
+    if ((pendingBuses & bit) == 0)
+      continue;
+    // Only thread context clears bits, interrupts set them for other buses
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    pendingBuses = pendingBuses & ~bit;
+    __set_PRIMASK(primask);
+    startBus(buses[i]);
+  }
+} // End of 'mthl::Sampler::service' function
+
+/* Check if sampler has work for thread context function */
+bool mthl::Sampler::isPending() const
+{
+  return pendingBuses != 0 ||
+    (busesCount != 0 && !isPaused && !isBusy() && !isSetReady && (triggerPins & ~readyPins) == 0);
+} // End of 'mthl::Sampler::isPending' function
+
+/* Pause or resume starting of new sample sets function */
+void mthl::Sampler::setPaused(bool isOn)
+{
+  isPaused = isOn;
+  // Pins are not waited for while sampler is paused
+  isWaiting = false;
+} // End of 'mthl::Sampler::setPaused' function
+
+/* Check if reading of sample set is in progress function */
+bool mthl::Sampler::isBusy() const
+{
+  return busyBuses != 0;
+} // End of 'mthl::Sampler::isBusy' function
+
+/* Check if finished sample set waits for dispatch function */
+bool mthl::Sampler::isReady() const
+{
+  return isSetReady && !isBusy();
+} // End of 'mthl::Sampler::isReady' function
+
+/* Hand finished sample set to sensors function */
+bool mthl::Sampler::dispatch()
+{
+  if (isBusy() || !isSetReady)
+    return false;
+
+  for (std::size_t i = 0; i < busesCount; ++i)
+    for (std::size_t j = 0; j < buses[i].count; ++j)
+      if (buses[i].isRead[j])
+        buses[i].sensors[j]->finishMotionRead();
+  isSetReady = false;
+
+  return true;
+} // End of 'mthl::Sampler::dispatch' function
+
+/* Drop finished sample set function */
+void mthl::Sampler::drop()
+{
+  isSetReady = false;
+} // End of 'mthl::Sampler::drop' function
+
+/* Data ready interrupt processing function */
+void mthl::Sampler::onDataReady(uint16_t pin)
+{
+  if ((triggerPins & pin) == 0)
+    return;
+
+  // Set is started from thread context
+  readyPins = readyPins | pin;
+} // End of 'mthl::Sampler::onDataReady' function
+
+/* Transfer completion processing function */
+void mthl::Sampler::onReadComplete(I2C_HandleTypeDef *hi2c)
+{
+  Bus *bus = findBus(hi2c);
+
+  if (bus == nullptr || bus->current >= bus->count)
+    return;
+
+  bus->isRead[bus->current] = true;
+  bus->current = bus->current + 1;
+  continueBus(*bus);
+} // End of 'mthl::Sampler::onReadComplete' function
+
+/* Transfer error processing function */
+void mthl::Sampler::onReadError(I2C_HandleTypeDef *hi2c)
+{
+  Bus *bus = findBus(hi2c);
+
+  if (bus == nullptr || bus->current >= bus->count)
+    return;
+
+  errorsCount = errorsCount + 1;
+  bus->current = bus->current + 1;
+  continueBus(*bus);
+} // End of 'mthl::Sampler::onReadError' function
+
+/* Number of failed transfers getter */
+uint32_t mthl::Sampler::getErrorsCount() const
+{
+  return errorsCount;
+} // End of 'mthl::Sampler::getErrorsCount' function
+
+/* Number of dropped data ready pins getter */
+uint32_t mthl::Sampler::getSilentPinsCount() const
+{
+  return silentPinsCount;
+} // End of 'mthl::Sampler::getSilentPinsCount' function
+
+/* Find bus by I2C handler function */
+mthl::Sampler::Bus * mthl::Sampler::findBus(I2C_HandleTypeDef *hi2c)
+{
+  for (std::size_t i = 0; i < busesCount; ++i)
+    if (buses[i].handle == hi2c)
+      return &buses[i];
+
+  return nullptr;
+} // End of 'mthl::Sampler::findBus' function
+
+/* Mark new sample set without any checks function */
+void mthl::Sampler::markSet()
+{
+  isSetReady = false;
+  for (std::size_t i = 0; i < busesCount; ++i)
+  {
+    buses[i].current = 0;
+    buses[i].isRead.fill(false);
+  }
+
+  // All buses are marked busy before first transfer, because it can finish before others start
+  busyBuses = busesCount;
+  pendingBuses = (1 << busesCount) - 1;
+} // End of 'mthl::Sampler::markSet' function
+
+/* Start reading sensors on bus from current one function */
+void mthl::Sampler::startBus(Bus &bus)
+{
+  while (bus.current < bus.count)
+  {
+    if (bus.sensors[bus.current]->startMotionRead() == HAL_OK)
+      return;
+    errorsCount = errorsCount + 1;
+    bus.current = bus.current + 1;
+  }
+
+  // Bus is finished, transfers of other buses can finish at the same time
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  finishBus();
+  __set_PRIMASK(primask);
+} // End of 'mthl::Sampler::startBus' function
+
+/* Continue reading sensors on bus after transfer function */
+void mthl::Sampler::continueBus(Bus &bus)
+{
+  if (bus.current < bus.count)
+    pendingBuses = pendingBuses | 1 << (&bus - buses.data());
+  else
+    finishBus();
+} // End of 'mthl::Sampler::continueBus' function
+
+/* Count finished bus function */
+void mthl::Sampler::finishBus()
+{
+  busyBuses = busyBuses - 1;
+  if (busyBuses == 0)
+    isSetReady = true;
+} // End of 'mthl::Sampler::finishBus' function
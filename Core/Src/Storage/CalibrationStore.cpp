@@ -0,0 +1,114 @@
+/******************************
+ * File name   : CalibrationStore.cpp
+ * Purpose     : Mithril project.
+ *               IMU-sensors calibration storage in flash class implementation
+ * Author      : Filippov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include <cstddef>
+
+#include "Storage/CalibrationStore.h"
+#include "Storage/Flash.h"
+#include "Telemetry/Telemetry.h"
+
+/* Load last stored record function */
+bool mthl::CalibrationStore::load()
+{
+  bool isFound = false;
+  uint32_t offset = 0;
+
+  // Records are appended, so last correct one is the newest
+  for (; offset + sizeof(Record) <= SIZE; offset += sizeof(Record))
+  {
+    if (flash::isErased(ADDRESS + offset, sizeof(Record)))
+      break;
+
+    const Record &rec = *reinterpret_cast<const Record *>(ADDRESS + offset);
+
+    // Record may be broken by reset during programming
+    if (rec.magic == MAGIC && rec.version == VERSION && rec.count <= MAX_SENSORS &&
+        rec.crc == evalCrc(rec))
+    {
+      record = rec;
+      isFound = true;
+    }
+  }
+  nextSlot = offset;
+
+  return isFound;
+} // End of 'mthl::CalibrationStore::load' function
+
+/* Restore sensor calibration function */
+bool mthl::CalibrationStore::restore(IMU &imu) const
+{
+  uint32_t id = imu.getId();
+
+  for (uint32_t i = 0; i < record.count; ++i)
+    if (record.entries[i].id == id)
+    {
+      IMU::Calibration calibration;
+
+      for (int32_t axis = 0; axis < 3; ++axis)
+      {
+        calibration.gyro[axis] = record.entries[i].gyro[axis];
+        calibration.angles[axis] = record.entries[i].angles[axis];
+      }
+      imu.setCalibration(calibration);
+      return true;
+    }
+
+  return false;
+} // End of 'mthl::CalibrationStore::restore' function
+
+/* Put sensor calibration to record function */
+bool mthl::CalibrationStore::put(IMU &imu)
+{
+  uint32_t id = imu.getId(), i = 0;
+
+  while (i < record.count && record.entries[i].id != id)
+    ++i;
+  if (i == MAX_SENSORS)
+    return false;
+  if (i == record.count)
+    record.count++;
+
+  IMU::Calibration calibration = imu.getCalibration();
+  Entry &entry = record.entries[i];
+
+  entry.id = id;
+  for (int32_t axis = 0; axis < 3; ++axis)
+  {
+    entry.gyro[axis] = calibration.gyro[axis];
+    entry.angles[axis] = calibration.angles[axis];
+  }
+  return true;
+} // End of 'mthl::CalibrationStore::put' function
+
+/* Save record to flash function */
+bool mthl::CalibrationStore::save()
+{
+  record.magic = MAGIC;
+  record.version = VERSION;
+  record.crc = evalCrc(record);
+
+  // Sector is erased when it is full or its free place is damaged
+  if (nextSlot + sizeof(Record) > SIZE || !flash::isErased(ADDRESS + nextSlot, sizeof(Record)))
+  {
+    if (!flash::erase(SECTOR))
+      return false;
+    nextSlot = 0;
+  }
+
+  bool isSaved = flash::program(ADDRESS + nextSlot, &record, sizeof(Record));
+
+  nextSlot += sizeof(Record);
+  return isSaved;
+} // End of 'mthl::CalibrationStore::save' function
+
+/* Evaluate record CRC function */
+uint32_t mthl::CalibrationStore::evalCrc(const Record &rec)
+{
+  return telemetry::crc16(reinterpret_cast<const uint8_t *>(&rec), offsetof(Record, crc));
+} // End of 'mthl::CalibrationStore::evalCrc' function
@@ -0,0 +1,65 @@
+/******************************
+ * File name   : Flash.cpp
+ * Purpose     : Mithril project.
+ *               Internal flash memory access functions
+ * Author      : Filippov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include "Storage/Flash.h"
+
+namespace
+{
+  /* Clear errors of previous flash operations function */
+  void clearErrors()
+  {
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR |
+        FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+  } // End of 'clearErrors' function
+}
+
+/* Erase sector function */
+bool mthl::flash::erase(uint32_t sector)
+{
+  FLASH_EraseInitTypeDef erase = {};
+  uint32_t badSector = 0;
+
+  erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+  erase.Sector = sector;
+  erase.NbSectors = 1;
+  erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+
+  HAL_FLASH_Unlock();
+  clearErrors();
+  HAL_StatusTypeDef status = HAL_FLASHEx_Erase(&erase, &badSector);
+  HAL_FLASH_Lock();
+
+  return status == HAL_OK;
+} // End of 'mthl::flash::erase' function
+
+/* Program words function */
+bool mthl::flash::program(uint32_t address, const void *data, uint32_t size)
+{
+  const uint32_t *words = static_cast<const uint32_t *>(data);
+  HAL_StatusTypeDef status = HAL_OK;
+
+  HAL_FLASH_Unlock();
+  clearErrors();
+  for (uint32_t i = 0; i < size / 4 && status == HAL_OK; ++i)
+    status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address + i * 4, words[i]);
+  HAL_FLASH_Lock();
+
+  return status == HAL_OK;
+} // End of 'mthl::flash::program' function
+
+/* Check if memory is erased function */
+bool mthl::flash::isErased(uint32_t address, uint32_t size)
+{
+  const uint32_t *words = reinterpret_cast<const uint32_t *>(address);
+
+  for (uint32_t i = 0; i < size / 4; ++i)
+    if (words[i] != 0xFFFFFFFF)
+      return false;
+  return true;
+} // End of 'mthl::flash::isErased' function
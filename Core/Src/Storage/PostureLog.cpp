@@ -0,0 +1,176 @@
+/******************************
+ * File name   : PostureLog.cpp
+ * Purpose     : Mithril project.
+ *               Posture history log in flash class implementation
+ * Author      : Filippov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include "Storage/PostureLog.h"
+#include "Storage/Flash.h"
+
+constexpr const uint32_t mthl::PostureLog::SECTORS[];
+constexpr const uint32_t mthl::PostureLog::ADDRESSES[];
+
+/* Find end of log and mark boot function */
+void mthl::PostureLog::init()
+{
+  bool isActiveValid = isValid(0), isOtherValid = isValid(1);
+
+  // The newest sector is active
+  if (isActiveValid && isOtherValid)
+    active = getSequence(1) - getSequence(0) < 0x80000000 ? 1 : 0;
+  else
+    active = isOtherValid ? 1 : 0;
+
+  uint32_t other = 1 - active;
+
+  if (!isValid(active) && !startSector(active))
+    return;
+  sequence = getSequence(active);
+  writeOffset = findEnd(active);
+  otherEnd = isValid(other) ? findEnd(other) : HEADER_SIZE;
+  // Sector could be erased ahead of time before reset
+  isNextErased = !isValid(other) && flash::isErased(ADDRESSES[other], SECTOR_SIZE);
+
+  // Boot number is the next after the last stored one
+  uint32_t bootNumber = 0;
+  Entry entry;
+
+  rewind();
+  while (read(entry))
+    if (entry.header >> 24 == static_cast<uint8_t>(Event::BOOT))
+      bootNumber = entry.data + 1;
+  append(Event::BOOT, bootNumber);
+  rewind();
+} // End of 'mthl::PostureLog::init' function
+
+/* Append event to log function */
+bool mthl::PostureLog::append(Event type, uint32_t data)
+{
+  if (sequence == 0)
+    return false;
+
+  // The oldest entries are dropped, sector is usually erased by 'prepare' already
+  if (writeOffset + sizeof(Entry) > SECTOR_SIZE)
+  {
+    otherEnd = writeOffset;
+    if (!startSector(1 - active))
+      return false;
+  }
+
+  Entry entry = {(HAL_GetTick() / 1000 & 0xFFFFFF) | static_cast<uint32_t>(type) << 24, data};
+
+  if (!flash::program(ADDRESSES[active] + writeOffset, &entry, sizeof(Entry)))
+    return false;
+  writeOffset += sizeof(Entry);
+  return true;
+} // End of 'mthl::PostureLog::append' function
+
+/* Check if sector for next entries has to be erased function */
+bool mthl::PostureLog::isPrepareNeeded() const
+{
+  return sequence != 0 && !isNextErased && writeOffset + PREPARE_MARGIN > SECTOR_SIZE;
+} // End of 'mthl::PostureLog::isPrepareNeeded' function
+
+/* Erase sector for next entries ahead of time function */
+bool mthl::PostureLog::prepare()
+{
+  if (!isPrepareNeeded())
+    return false;
+
+  // The oldest entries are dropped before active sector is full, reading skips them
+  otherEnd = HEADER_SIZE;
+  if (!flash::erase(SECTORS[1 - active]))
+    return false;
+  isNextErased = true;
+  return true;
+} // End of 'mthl::PostureLog::prepare' function
+
+/* Start reading from the oldest entry function */
+void mthl::PostureLog::rewind()
+{
+  uint32_t other = 1 - active;
+
+  // The other sector keeps older entries if it was active just before
+  if (isValid(other) && getSequence(other) + 1 == sequence)
+    readSector = other;
+  else
+    readSector = active;
+  readOffset = HEADER_SIZE;
+} // End of 'mthl::PostureLog::rewind' function
+
+/* Read next entry function */
+bool mthl::PostureLog::read(Entry &entry)
+{
+  if (readSector != active && readOffset >= otherEnd)
+  {
+    readSector = active;
+    readOffset = HEADER_SIZE;
+  }
+  if (readSector == active && readOffset >= writeOffset)
+    return false;
+
+  entry = *reinterpret_cast<const Entry *>(ADDRESSES[readSector] + readOffset);
+  readOffset += sizeof(Entry);
+  return true;
+} // End of 'mthl::PostureLog::read' function
+
+/* Check if sector has correct header function */
+bool mthl::PostureLog::isValid(uint32_t index)
+{
+  return *reinterpret_cast<const uint32_t *>(ADDRESSES[index]) == MAGIC && getSequence(index) != 0 &&
+    getSequence(index) != 0xFFFFFFFF;
+} // End of 'mthl::PostureLog::isValid' function
+
+/* Sequence number of sector getter */
+uint32_t mthl::PostureLog::getSequence(uint32_t index)
+{
+  return *reinterpret_cast<const uint32_t *>(ADDRESSES[index] + 4);
+} // End of 'mthl::PostureLog::getSequence' function
+
+/* Find end of entries in sector function */
+uint32_t mthl::PostureLog::findEnd(uint32_t index)
+{
+  // Entries are written without gaps, so free entries are at the end
+  uint32_t low = 0, high = (SECTOR_SIZE - HEADER_SIZE) / sizeof(Entry);
+
+  while (low < high)
+  {
+    uint32_t middle = (low + high) / 2;
+
+    if (flash::isErased(ADDRESSES[index] + HEADER_SIZE + middle * sizeof(Entry), sizeof(Entry)))
+      high = middle;
+    else
+      low = middle + 1;
+  }
+  return HEADER_SIZE + low * sizeof(Entry);
+} // End of 'mthl::PostureLog::findEnd' function
+
+/* Erase sector and make it active function */
+bool mthl::PostureLog::startSector(uint32_t index)
+{
+  uint32_t header[2] = {MAGIC, sequence + 1};
+
+  // Sequence number 0 marks log without sectors
+  if (header[1] == 0 || header[1] == 0xFFFFFFFF)
+    header[1] = 1;
+
+  bool isErased = isNextErased && index != active;
+
+  isNextErased = false;
+  if ((!isErased && !flash::erase(SECTORS[index])) || !flash::program(ADDRESSES[index], header, sizeof(header)))
+  {
+    sequence = 0;
+    return false;
+  }
+
+  active = index;
+  sequence = header[1];
+  writeOffset = HEADER_SIZE;
+  // Reading of erased entries is stopped
+  if (readSector == index)
+    readOffset = HEADER_SIZE;
+  return true;
+} // End of 'mthl::PostureLog::startSector' function
@@ -0,0 +1,169 @@
+/******************************
+ * File name   : Telemetry.cpp
+ * Purpose     : Mithril project.
+ *               Binary telemetry protocol implementation
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include "Telemetry/Telemetry.h"
+
+namespace
+{
+  /* CRC16 table structure */
+  struct CrcTable
+  {
+    uint16_t values[256]; // CRC16 of each byte value
+  }; // End of 'CrcTable' structure
+
+  /* Build CRC16 table function.
+   * Arguments: None.
+   *
+   * Returns:
+   *   CRC16 table.
+   */
+  constexpr CrcTable makeCrcTable()
+  {
+    CrcTable table{};
+
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+      uint16_t crc = i << 8;
+
+      for (int32_t bit = 0; bit < 8; ++bit)
+        crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+      table.values[i] = crc;
+    }
+    return table;
+  } // End of 'makeCrcTable' function
+
+  /* CRC16 table. It is built at compile time, so it is placed in flash */
+  constexpr const CrcTable crcTable = makeCrcTable();
+}
+
+/* Evaluate CRC16 function */
+uint16_t mthl::telemetry::crc16(const uint8_t *data, uint32_t len)
+{
+  uint16_t crc = 0xFFFF;
+
+  for (uint32_t i = 0; i < len; ++i)
+    crc = (crc << 8) ^ crcTable.values[(crc >> 8) ^ data[i]];
+  return crc;
+} // End of 'mthl::telemetry::crc16' function
+
+/* Encode bytes with COBS function */
+uint32_t mthl::telemetry::cobsEncode(const uint8_t *src, uint32_t len, uint8_t *dst)
+{
+  // Each block starts with code: distance to next zero (or block end)
+  uint32_t codePos = 0, pos = 1;
+  uint8_t code = 1;
+
+  for (uint32_t i = 0; i < len; ++i)
+  {
+    if (src[i] != 0)
+    {
+      dst[pos++] = src[i];
+      ++code;
+    }
+    if (src[i] == 0 || code == 0xFF)
+    {
+      dst[codePos] = code;
+      code = 1;
+      codePos = pos++;
+    }
+  }
+  dst[codePos] = code;
+  return pos;
+} // End of 'mthl::telemetry::cobsEncode' function
+
+/* Decode COBS bytes function */
+uint32_t mthl::telemetry::cobsDecode(const uint8_t *src, uint32_t len, uint8_t *dst)
+{
+  uint32_t pos = 0, i = 0;
+
+  while (i < len)
+  {
+    uint8_t code = src[i++];
+
+    if (code == 0 || i + code - 1 > len)
+      return 0;
+    for (uint8_t j = 1; j < code; ++j)
+    {
+      if (src[i] == 0)
+        return 0;
+      dst[pos++] = src[i++];
+    }
+    // Block shorter than maximal one ends with zero which is not present after last block
+    if (code != 0xFF && i < len)
+      dst[pos++] = 0;
+  }
+  return pos;
+} // End of 'mthl::telemetry::cobsDecode' function
+
+/* Frame constructor */
+mthl::telemetry::Frame::Frame(Message type, uint32_t time) : packet{}, size(HEADER_SIZE)
+{
+  packet[0] = VERSION;
+  packet[1] = static_cast<uint8_t>(type);
+  packet[3] = time & 0xFF;
+  packet[4] = (time >> 8) & 0xFF;
+  packet[5] = (time >> 16) & 0xFF;
+  packet[6] = (time >> 24) & 0xFF;
+} // End of 'mthl::telemetry::Frame::Frame' constructor
+
+/* Put unsigned byte to payload function */
+mthl::telemetry::Frame & mthl::telemetry::Frame::putU8(uint8_t value)
+{
+  if (size < HEADER_SIZE + MAX_PAYLOAD_SIZE)
+    packet[size++] = value;
+  return *this;
+} // End of 'mthl::telemetry::Frame::putU8' function
+
+/* Put signed 16-bit number to payload function */
+mthl::telemetry::Frame & mthl::telemetry::Frame::putI16(int16_t value)
+{
+  if (size + 2 > HEADER_SIZE + MAX_PAYLOAD_SIZE)
+    return *this;
+  packet[size++] = (uint16_t)value & 0xFF;
+  packet[size++] = (uint16_t)value >> 8;
+  return *this;
+} // End of 'mthl::telemetry::Frame::putI16' function
+
+/* Put unsigned 32-bit number to payload function */
+mthl::telemetry::Frame & mthl::telemetry::Frame::putU32(uint32_t value)
+{
+  if (size + 4 > HEADER_SIZE + MAX_PAYLOAD_SIZE)
+    return *this;
+  for (int32_t i = 0; i < 4; ++i)
+    packet[size++] = value >> 8 * i & 0xFF;
+  return *this;
+} // End of 'mthl::telemetry::Frame::putU32' function
+
+/* Put scaled physical value to payload function */
+mthl::telemetry::Frame & mthl::telemetry::Frame::putScaled(float value, float scale)
+{
+  float scaled = value * scale;
+
+  if (scaled >= 32767)
+    return putI16(32767);
+  if (scaled <= -32768)
+    return putI16(-32768);
+  return putI16((int16_t)(scaled < 0 ? scaled - 0.5f : scaled + 0.5f));
+} // End of 'mthl::telemetry::Frame::putScaled' function
+
+/* Encode frame function */
+uint32_t mthl::telemetry::Frame::encode(uint8_t sequence, uint8_t *dst)
+{
+  packet[2] = sequence;
+
+  uint16_t crc = crc16(packet, size);
+
+  packet[size] = crc & 0xFF;
+  packet[size + 1] = crc >> 8;
+
+  uint32_t len = cobsEncode(packet, size + CRC_SIZE, dst);
+
+  dst[len++] = 0;
+  return len;
+} // End of 'mthl::telemetry::Frame::encode' function
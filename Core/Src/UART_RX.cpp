@@ -0,0 +1,102 @@
+/******************************
+ * File name   : UART_RX.cpp
+ * Purpose     : Mithrill project.
+ *               UART circular DMA reception
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include "UART_RX.h"
+
+/* UART handler 6 (for bluetooth) */
+extern UART_HandleTypeDef huart6;
+
+namespace
+{
+  /* Streams of all UARTs which receive commands */
+  mthl::RxStream streams[] =
+  {
+    {&huart6}
+  };
+}
+
+/* Find stream of UART function */
+mthl::RxStream * mthl::RxStream::find(UART_HandleTypeDef *huart)
+{
+  for (auto &stream : streams)
+    if (stream.huart == huart)
+      return &stream;
+
+  return nullptr;
+} // End of 'mthl::RxStream::find' function
+
+/* Start reception function */
+bool mthl::RxStream::start()
+{
+  readPos = 0;
+  if (HAL_UART_Receive_DMA(huart, buffer, SIZE) != HAL_OK)
+    return false;
+  __HAL_UART_CLEAR_IDLEFLAG(huart);
+  __HAL_UART_ENABLE_IT(huart, UART_IT_IDLE);
+  return true;
+} // End of 'mthl::RxStream::start' function
+
+/* Pass bytes received since previous call function */
+void mthl::RxStream::poll()
+{
+  // DMA counts bytes left to the end of buffer
+  uint32_t writePos = SIZE - __HAL_DMA_GET_COUNTER(huart->hdmarx);
+
+  if (writePos == SIZE)
+    writePos = 0;
+  if (writePos == readPos)
+    return;
+
+  if (writePos > readPos)
+    UART_RxEventCallback(huart, buffer + readPos, writePos - readPos);
+  else
+  {
+    UART_RxEventCallback(huart, buffer + readPos, SIZE - readPos);
+    if (writePos != 0)
+      UART_RxEventCallback(huart, buffer, writePos);
+  }
+  readPos = writePos;
+} // End of 'mthl::RxStream::poll' function
+
+/* Reception error processing function */
+void mthl::RxStream::onError()
+{
+  uint32_t error = huart->ErrorCode;
+
+  if (error & HAL_UART_ERROR_ORE)
+    overrunsCount = overrunsCount + 1;
+  if (error & HAL_UART_ERROR_FE)
+    framingErrorsCount = framingErrorsCount + 1;
+  if (error & (HAL_UART_ERROR_NE | HAL_UART_ERROR_PE))
+    noiseErrorsCount = noiseErrorsCount + 1;
+
+  // HAL stops DMA reception on any error, bytes received before it are kept
+  if (huart->RxState != HAL_UART_STATE_READY)
+    return;
+  poll();
+  start();
+} // End of 'mthl::RxStream::onError' function
+
+/* Number of overrun errors getter */
+uint32_t mthl::RxStream::getOverrunsCount() const
+{
+  return overrunsCount;
+} // End of 'mthl::RxStream::getOverrunsCount' function
+
+/* Number of framing errors getter */
+uint32_t mthl::RxStream::getFramingErrorsCount() const
+{
+  return framingErrorsCount;
+} // End of 'mthl::RxStream::getFramingErrorsCount' function
+
+/* Number of noise and parity errors getter */
+uint32_t mthl::RxStream::getNoiseErrorsCount() const
+{
+  return noiseErrorsCount;
+} // End of 'mthl::RxStream::getNoiseErrorsCount' function
@@ -0,0 +1,188 @@
+/******************************
+ * File name   : UART_TX.cpp
+ * Purpose     : Mithrill project.
+ *               Non-blocking UART transmit queue
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include "UART_TX.h"
+#include "Probe.h"
+
+/* UART handler 2 */
+extern UART_HandleTypeDef huart2;
+/* UART handler 6 (for bluetooth) */
+extern UART_HandleTypeDef huart6;
+
+namespace
+{
+  /* Queues of all UARTs. Debug output keeps the newest data, application
+   * output is never dropped in main loop.
+   */
+  mthl::TxQueue queues[] =
+  {
+    {&huart2, mthl::TxQueue::Overflow::DROP_OLDEST},
+    {&huart6, mthl::TxQueue::Overflow::BLOCK}
+  };
+}
+
+/* Find queue of UART function */
+mthl::TxQueue * mthl::TxQueue::find(UART_HandleTypeDef *huart)
+{
+  for (auto &queue : queues)
+    if (queue.huart == huart)
+      return &queue;
+
+  return nullptr;
+} // End of 'mthl::TxQueue::find' function
+
+/* Put bytes to queue function */
+uint32_t mthl::TxQueue::write(const uint8_t *data, uint32_t len)
+{
+  MTHL_PROBE(UART_WRITE);
+  uint32_t queued = 0;
+  // Waiting is impossible in interrupt or with disabled interrupts
+  bool canBlock = policy == Overflow::BLOCK && __get_IPSR() == 0 && __get_PRIMASK() == 0;
+
+  while (len > 0)
+  {
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    uint32_t free = SIZE - (head - tail);
+
+    if (free < len && policy == Overflow::DROP_OLDEST)
+    {
+      // Only last bytes of data fit in queue
+      if (len > SIZE)
+      {
+        droppedCount = droppedCount + (len - SIZE);
+        data += len - SIZE;
+        len = SIZE;
+      }
+      droppedCount = droppedCount + (len - free);
+      tail = tail + (len - free);
+      free = len;
+    }
+    __set_PRIMASK(primask);
+
+    // Place after head is not used by transfer, so it is filled with enabled interrupts
+    uint32_t count = len < free ? len : free;
+
+    for (uint32_t i = 0; i < count; ++i)
+      buffer[(head + i) & (SIZE - 1)] = data[i];
+
+    __disable_irq();
+    head = head + count;
+    startTransfer();
+    __set_PRIMASK(primask);
+
+    data += count;
+    len -= count;
+    queued += count;
+    if (len == 0)
+      break;
+
+    if (!canBlock)
+    {
+      droppedCount = droppedCount + len;
+      break;
+    }
+    // Wait till sent chunk frees place. Transfer is restarted on each wakeup, because
+    // it could not be started if UART was busy (and nothing else would start it)
+    while (head - tail == SIZE)
+    {
+      __disable_irq();
+      startTransfer();
+      __set_PRIMASK(primask);
+      if (head - tail == SIZE)
+        __WFI();
+    }
+  }
+
+  return queued;
+} // End of 'mthl::TxQueue::write' function
+
+/* Wait till all queued bytes are sent function */
+void mthl::TxQueue::flush()
+{
+  // It can be called from critical section, so interrupts mask is kept
+  uint32_t primask = __get_PRIMASK();
+
+  while (!isIdle())
+  {
+    // Restart transfer which could not be started because UART was busy
+    __disable_irq();
+    startTransfer();
+    __set_PRIMASK(primask);
+    // Transfer completion is not handled while interrupts are disabled
+    if (primask != 0)
+      break;
+    __WFI();
+  }
+} // End of 'mthl::TxQueue::flush' function
+
+/* Check if all queued bytes are sent function */
+bool mthl::TxQueue::isIdle() const
+{
+  return !isBusy && head == tail;
+} // End of 'mthl::TxQueue::isIdle' function
+
+/* Overflow policy setter */
+void mthl::TxQueue::setOverflowPolicy(Overflow policy)
+{
+  this->policy = policy;
+} // End of 'mthl::TxQueue::setOverflowPolicy' function
+
+/* Overflow policy getter */
+mthl::TxQueue::Overflow mthl::TxQueue::getOverflowPolicy() const
+{
+  return policy;
+} // End of 'mthl::TxQueue::getOverflowPolicy' function
+
+/* Number of dropped bytes getter */
+uint32_t mthl::TxQueue::getDroppedCount() const
+{
+  return droppedCount;
+} // End of 'mthl::TxQueue::getDroppedCount' function
+
+/* Transfer completion processing function */
+void mthl::TxQueue::onTxComplete()
+{
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  isBusy = false;
+  startTransfer();
+  __set_PRIMASK(primask);
+} // End of 'mthl::TxQueue::onTxComplete' function
+
+/* Transfer error processing function */
+void mthl::TxQueue::onTxError()
+{
+  // Errors of reception do not stop transfer
+  if (huart->gState != HAL_UART_STATE_READY)
+    return;
+  onTxComplete();
+} // End of 'mthl::TxQueue::onTxError' function
+
+/* Start transfer of next chunk if UART is free function */
+void mthl::TxQueue::startTransfer()
+{
+  if (isBusy || head == tail)
+    return;
+
+  // Chunk is copied, so its place in queue is free during transfer
+  uint32_t count = head - tail;
+
+  if (count > CHUNK_SIZE)
+    count = CHUNK_SIZE;
+  for (uint32_t i = 0; i < count; ++i)
+    dmaBuffer[i] = buffer[(tail + i) & (SIZE - 1)];
+
+  if (HAL_UART_Transmit_DMA(huart, dmaBuffer, count) != HAL_OK)
+    return;
+  tail = tail + count;
+  isBusy = true;
+} // End of 'mthl::TxQueue::startTransfer' function
@@ -24,6 +24,9 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "Controller/Controller.h"
+#include "Timer.h"
+#include "UART_TX.h"
+#include "UART_RX.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -43,11 +46,15 @@
 /* Private variables ---------------------------------------------------------*/
 I2C_HandleTypeDef hi2c1;
 I2C_HandleTypeDef hi2c3;
+DMA_HandleTypeDef hdma_i2c1_rx;
+DMA_HandleTypeDef hdma_i2c3_rx;
 
 UART_HandleTypeDef huart2;
 UART_HandleTypeDef huart6;
+DMA_HandleTypeDef hdma_usart2_tx;
+DMA_HandleTypeDef hdma_usart6_tx;
+DMA_HandleTypeDef hdma_usart6_rx;
 
-uint8_t rx[1];
 uint8_t tx[1] = {78};
 /* USER CODE BEGIN PV */
 
@@ -56,11 +63,13 @@ uint8_t tx[1] = {78};
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
+static void MX_DMA_Init(void);
 static void MX_I2C1_Init(void);
 static void MX_USART2_UART_Init(void);
 static void MX_USART6_UART_Init(void);
 static void MX_I2C3_Init(void);
 /* USER CODE BEGIN PFP */
+static void MX_EXTI_Init(void);
 
 /* USER CODE END PFP */
 
@@ -92,21 +101,26 @@ int main(void)
   SystemClock_Config();
 
   /* USER CODE BEGIN SysInit */
+  /* Cycle counter is used for sensors samples timestamps */
+  mthl::timer::init();
 
   /* USER CODE END SysInit */
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
+  MX_DMA_Init();
   MX_I2C1_Init();
   MX_USART2_UART_Init();
   MX_USART6_UART_Init();
   MX_I2C3_Init();
 
-  /* Itialize of UART6 interrupt */
-  HAL_UART_Receive_IT(&huart6, rx, sizeof(rx));
   /* USER CODE BEGIN 2 */
   mthl::Controller &controller = mthl::Controller::getInstance();
 
+  /* Data ready interrupts and received commands use controller, so they are enabled after it is created */
+  MX_EXTI_Init();
+  mthl::RxStream::find(&huart6)->start();
+
   controller.Run();
 }
 
@@ -282,6 +296,35 @@ static void MX_USART6_UART_Init(void)
 
 }
 
+/** 
+  * Enable DMA controller clock
+  */
+static void MX_DMA_Init(void) 
+{
+
+  /* DMA controller clock enable */
+  __HAL_RCC_DMA1_CLK_ENABLE();
+  __HAL_RCC_DMA2_CLK_ENABLE();
+
+  /* DMA interrupt init */
+  /* DMA1_Stream0_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA1_Stream0_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Stream0_IRQn);
+  /* DMA1_Stream2_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA1_Stream2_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Stream2_IRQn);
+  /* DMA1_Stream6_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA1_Stream6_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Stream6_IRQn);
+  /* DMA2_Stream1_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA2_Stream1_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA2_Stream1_IRQn);
+  /* DMA2_Stream6_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA2_Stream6_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA2_Stream6_IRQn);
+
+}
+
 /**
   * @brief GPIO Initialization Function
   * @param None
@@ -306,20 +349,138 @@ static void MX_GPIO_Init(void)
   GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
   HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
 
+  /*Configure GPIO pins : PC0 PC1 PC2 */
+  GPIO_InitStruct.Pin = GPIO_PIN_0|GPIO_PIN_1|GPIO_PIN_2;
+  GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING;
+  GPIO_InitStruct.Pull = GPIO_PULLDOWN;
+  HAL_GPIO_Init(GPIOC, &GPIO_InitStruct);
+
 }
 
 /* USER CODE BEGIN 4 */
-/* Receive interrupt call back function.
+/**
+  * @brief IMU-sensors data ready interrupts initialization function.
+  *        Pins PC0 PC1 PC2 are configured in MX_GPIO_Init, their interrupts
+  *        are not enabled there (Mithril.ioc), because they use controller.
+  * @retval None
+  */
+static void MX_EXTI_Init(void)
+{
+  /* EXTI interrupt init*/
+  HAL_NVIC_SetPriority(EXTI0_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(EXTI0_IRQn);
+  HAL_NVIC_SetPriority(EXTI1_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(EXTI1_IRQn);
+  HAL_NVIC_SetPriority(EXTI2_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(EXTI2_IRQn);
+
+}
+
+/* Received bytes call back function.
+ * Argumenst:
+ *   UART_HandleTypeDef *huart -- UART handler.
+ *   const uint8_t *data -- received bytes.
+ *   uint32_t len -- number of bytes.
+ */
+void UART_RxEventCallback(UART_HandleTypeDef *huart, const uint8_t *data, uint32_t len)
+{
+  static auto &controller = mthl::Controller::getInstance();
+  mthl::Request request(0);
+
+  for (uint32_t i = 0; i < len; ++i)
+    if (controller.cmdParser.feed(data[i], request))
+      controller.reqQueue.push(request);
+} // End of 'UART_RxEventCallback' function
+
+/* Receive half of buffer call back function.
+ * Argumenst:
+ *   UART_HandleTypeDef *huart -- UART handler.
+ */
+void HAL_UART_RxHalfCpltCallback(UART_HandleTypeDef *huart)
+{
+  mthl::RxStream *stream = mthl::RxStream::find(huart);
+
+  if (stream != nullptr)
+    stream->poll();
+} // End of 'HAL_UART_RxHalfCpltCallback' function
+
+/* Receive whole buffer call back function.
  * Argumenst:
  *   UART_HandleTypeDef *huart -- UART handler.
  */
 void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
 {
-  static std::queue<mthl::Request> &reqQueue = mthl::Controller::getInstance().reqQueue;
-  if (mthl::Request::fromByteToCmdMap.find(rx[0]) != mthl::Request::fromByteToCmdMap.end())
-    reqQueue.push(mthl::Request(rx[0]));
-  HAL_UART_Receive_IT(&huart6, rx, sizeof(rx));
+  mthl::RxStream *stream = mthl::RxStream::find(huart);
+
+  if (stream != nullptr)
+    stream->poll();
 } // End of 'HAL_UART_RxCpltCallback' function
+
+/* UART idle line call back function.
+ * Argumenst:
+ *   UART_HandleTypeDef *huart -- UART handler.
+ */
+void UART_IdleCallback(UART_HandleTypeDef *huart)
+{
+  mthl::RxStream *stream = mthl::RxStream::find(huart);
+
+  if (stream != nullptr)
+    stream->poll();
+} // End of 'UART_IdleCallback' function
+
+/* UART transmission finished call back function.
+ * Argumenst:
+ *   UART_HandleTypeDef *huart -- UART handler.
+ */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+  mthl::TxQueue *queue = mthl::TxQueue::find(huart);
+
+  if (queue != nullptr)
+    queue->onTxComplete();
+} // End of 'HAL_UART_TxCpltCallback' function
+
+/* UART error call back function.
+ * Argumenst:
+ *   UART_HandleTypeDef *huart -- UART handler.
+ */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+  mthl::TxQueue *queue = mthl::TxQueue::find(huart);
+  mthl::RxStream *stream = mthl::RxStream::find(huart);
+
+  if (stream != nullptr)
+    stream->onError();
+  if (queue != nullptr)
+    queue->onTxError();
+} // End of 'HAL_UART_ErrorCallback' function
+
+/* I2C memory reading finished call back function.
+ * Argumenst:
+ *   I2C_HandleTypeDef *hi2c -- I2C handler.
+ */
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  mthl::Controller::getInstance().sampler.onReadComplete(hi2c);
+} // End of 'HAL_I2C_MemRxCpltCallback' function
+
+/* I2C error call back function.
+ * Argumenst:
+ *   I2C_HandleTypeDef *hi2c -- I2C handler.
+ */
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+  mthl::Controller::getInstance().sampler.onReadError(hi2c);
+} // End of 'HAL_I2C_ErrorCallback' function
+
+/* External interrupt call back function.
+ * Argumenst:
+ *   uint16_t GPIO_Pin -- pin of interrupt.
+ */
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+  mthl::Controller::getInstance().sampler.onDataReady(GPIO_Pin);
+} // End of 'HAL_GPIO_EXTI_Callback' function
 /* USER CODE END 4 */
 
 /**
@@ -0,0 +1,166 @@
+/******************************
+ * File name   : HostCore.h
+ * Purpose     : Mithril project.
+ *               Host build module.
+ *               Simulated Cortex-M core peripherals declaration
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __HOST_CORE_H_
+#define __HOST_CORE_H_
+
+#include <stdint.h>
+
+/* Core peripherals are placed at addresses which can't be mapped on host
+ * (and are used by sanitizers), so they are replaced by host objects. SysTick and
+ * DWT cycle counter are evaluated from virtual time of simulator, other core
+ * registers (and debug MCU registers) are plain memory. Cycle counter stops while
+ * CPU sleeps, unless DBG_SLEEP bit of DBGMCU->CR is set, as on device.
+ * Replacement is done for C++ sources only.
+ */
+#ifdef __cplusplus
+
+/* HAL headers include configuration inside C linkage block */
+extern "C++"
+{
+/* Mithril namespace */
+namespace mthl
+{
+  /* Host build namespace */
+  namespace host
+  {
+    /* SysTick register enum class declaration */
+    enum class SysTickField
+    {
+      CTRL, LOAD, VAL, CALIB
+    }; // End of 'SysTickField' enum class
+
+    /* Read SysTick register function.
+     *
+     * Arguments:
+     *   SysTickField field -- register
+     *
+     * Returns:
+     *   Register value at current virtual time.
+     */
+    uint32_t readSysTick(SysTickField field);
+
+    /* Write SysTick register function.
+     *
+     * Arguments:
+     *   SysTickField field -- register
+     *   uint32_t value -- value to write
+     *
+     * Returns:
+     *   None.
+     */
+    void writeSysTick(SysTickField field, uint32_t value);
+
+    /* Cycle counter getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Virtual CPU cycles since start (32 lower bits).
+     */
+    uint32_t readCycleCounter();
+
+    /* Cycle counter setter.
+     *
+     * Arguments:
+     *   uint32_t value -- new counter value
+     *
+     * Returns:
+     *   None.
+     */
+    void writeCycleCounter(uint32_t value);
+
+    /* SysTick register class declaration */
+    template<SysTickField Field>
+    class SysTickRegister final
+    {
+    public:
+      operator uint32_t() const
+      {
+        return readSysTick(Field);
+      }
+
+      SysTickRegister & operator=(uint32_t value)
+      {
+        writeSysTick(Field, value);
+        return *this;
+      }
+
+      SysTickRegister & operator|=(uint32_t value)
+      {
+        return *this = readSysTick(Field) | value;
+      }
+
+      // Inverted masks are 64-bit on host
+      SysTickRegister & operator&=(uint64_t value)
+      {
+        return *this = readSysTick(Field) & static_cast<uint32_t>(value);
+      }
+    }; // End of 'SysTickRegister' class
+
+    /* SysTick registers structure */
+    struct SysTickRegisters final
+    {
+      SysTickRegister<SysTickField::CTRL> CTRL;
+      SysTickRegister<SysTickField::LOAD> LOAD;
+      SysTickRegister<SysTickField::VAL> VAL;
+      SysTickRegister<SysTickField::CALIB> CALIB;
+    }; // End of 'SysTickRegisters' structure
+
+    /* DWT cycle counter register class declaration */
+    class CycleCounterRegister final
+    {
+    public:
+      operator uint32_t() const
+      {
+        return readCycleCounter();
+      }
+
+      CycleCounterRegister & operator=(uint32_t value)
+      {
+        writeCycleCounter(value);
+        return *this;
+      }
+    }; // End of 'CycleCounterRegister' class
+
+    /* DWT registers structure */
+    struct DwtRegisters final
+    {
+      uint32_t CTRL = 0;           // control register (counter is always enabled)
+      CycleCounterRegister CYCCNT; // cycle counter
+    }; // End of 'DwtRegisters' structure
+
+    extern SysTickRegisters sysTick;   // SysTick timer
+    extern DwtRegisters dwt;           // data watchpoint and trace unit
+    extern SCB_Type scb;               // system control block
+    extern NVIC_Type nvic;             // interrupt controller
+    extern CoreDebug_Type coreDebug;   // core debug registers
+    extern DBGMCU_TypeDef dbgmcu;      // debug MCU registers
+  } // end of 'host' namespace
+} // end of 'mthl' namespace
+}
+
+#undef SysTick
+#define SysTick (&mthl::host::sysTick)
+#undef DWT
+#define DWT (&mthl::host::dwt)
+#undef SCB
+#define SCB (&mthl::host::scb)
+#undef NVIC
+#define NVIC (&mthl::host::nvic)
+#undef CoreDebug
+#define CoreDebug (&mthl::host::coreDebug)
+#undef DBGMCU
+#define DBGMCU (&mthl::host::dbgmcu)
+
+#endif /* __cplusplus */
+
+#endif /* __HOST_CORE_H_ */
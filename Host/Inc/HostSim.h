@@ -0,0 +1,146 @@
+/******************************
+ * File name   : HostSim.h
+ * Purpose     : Mithril project.
+ *               Host build module.
+ *               Board simulator declaration
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __HOST_SIM_H_
+#define __HOST_SIM_H_
+
+#include <functional>
+#include <vector>
+
+#include "stm32f4xx_hal.h"
+
+/* Mithril namespace */
+namespace mthl
+{
+  /* Host build namespace.
+   * Firmware runs on host against HAL implemented by simulator. Time is virtual:
+   * it is counted in CPU cycles and passes only while CPU sleeps (WFI), polls tick
+   * or waits for blocking transfers, so runs are deterministic and independent of
+   * host speed. Interrupts are handlers which are run when their time comes and
+   * interrupts are not masked. All interrupts have the same priority, as in
+   * firmware, so handlers do not preempt each other.
+   *
+   * Simulation is set up with environment variables:
+   *   MITHRIL_SIM_TIME   -- virtual time to run (seconds, default 10)
+   *   MITHRIL_SIM_INPUT  -- script of bytes sent to application link, lines
+   *                         "<time in milliseconds> <hex bytes>", '#' starts comment
+   *   MITHRIL_SIM_UART6  -- file for bytes sent to application link
+   *   MITHRIL_SIM_FLASH  -- flash image file, it is loaded at start and saved at exit
+   *   MITHRIL_SIM_TILT   -- tilt of IMU-sensors around Y axis (degrees, default 0),
+   *                         it is used by default motion source
+   *   MITHRIL_SIM_TILT_TIME -- time when IMU-sensors are turned to tilt (seconds, default 0),
+   *                         they lie flat before it
+   *   MITHRIL_SIM_SILENT_INT -- number of IMU-sensor (in board wiring) which data ready
+   *                         interrupt line is cut
+   * Debug output (USART2) is printed to stdout.
+   */
+  namespace host
+  {
+    using Cycles = uint64_t; // Virtual time (CPU cycles)
+
+    /* Virtual time getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   CPU cycles since start.
+     */
+    Cycles getTime();
+
+    /* Convert microseconds to CPU cycles function.
+     *
+     * Arguments:
+     *   double us -- time (microseconds)
+     *
+     * Returns:
+     *   Number of CPU cycles.
+     */
+    Cycles fromMicroseconds(double us);
+
+    /* Pass virtual time function.
+     * Interrupts which come meanwhile are run if they are not masked.
+     *
+     * Arguments:
+     *   Cycles cycles -- time to pass
+     *
+     * Returns:
+     *   None.
+     */
+    void advance(Cycles cycles);
+
+    /* Schedule interrupt function.
+     *
+     * Arguments:
+     *   Cycles delay -- time to interrupt
+     *   std::function<void()> handler -- interrupt handler
+     *
+     * Returns:
+     *   None.
+     */
+    void schedule(Cycles delay, std::function<void()> handler);
+
+    /* Send bytes to UART receiver function.
+     * Bytes come one by one with UART speed, idle line is detected after them.
+     *
+     * Arguments:
+     *   UART_HandleTypeDef *huart -- receiving UART
+     *   const std::vector<uint8_t> &data -- bytes to send
+     *
+     * Returns:
+     *   None.
+     */
+    void sendToUart(UART_HandleTypeDef *huart, const std::vector<uint8_t> &data);
+
+    /* Bytes sent by UART getter.
+     *
+     * Arguments:
+     *   UART_HandleTypeDef *huart -- UART
+     *
+     * Returns:
+     *   All bytes transmitted by UART.
+     */
+    const std::vector<uint8_t> & getUartOutput(UART_HandleTypeDef *huart);
+
+    /* IMU-sensor motion structure */
+    struct Motion
+    {
+      float accel[3]; // acceleration (g)
+      float gyro[3];  // angular velocity (degrees per second)
+    }; // End of 'Motion' structure
+
+    /* Motion source type: gives motion of sensor (number in board wiring) at time (seconds) */
+    using MotionSource = std::function<Motion (uint32_t sensor, double time)>;
+
+    /* Set motion of simulated IMU-sensors function.
+     * By default sensors lie still (tilted by MITHRIL_SIM_TILT) with small gyroscope bias.
+     *
+     * Arguments:
+     *   MotionSource source -- motion source
+     *
+     * Returns:
+     *   None.
+     */
+    void setMotionSource(MotionSource source);
+
+    /* Stop simulation function.
+     * Output is saved and program exits.
+     *
+     * Arguments:
+     *   int code -- exit code
+     *
+     * Returns:
+     *   None.
+     */
+    [[noreturn]] void stop(int code);
+  } // end of 'host' namespace
+} // end of 'mthl' namespace
+
+#endif // __HOST_SIM_H_
@@ -0,0 +1,124 @@
+/******************************
+ * File name   : Mpu6050Sim.h
+ * Purpose     : Mithril project.
+ *               Host build module.
+ *               Simulated MPU6050 IMU-sensor class declaration
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __MPU6050_SIM_H_
+#define __MPU6050_SIM_H_
+
+#include <deque>
+
+#include "HostSim.h"
+
+/* Mithril namespace */
+namespace mthl
+{
+  /* Host build namespace */
+  namespace host
+  {
+    /* Simulated MPU6050 class declaration.
+     * Device answers register reads and writes on I2C bus. After waking up it makes
+     * samples with configured rate from motion source: updates data registers, puts
+     * data to FIFO and pulses INT pin (EXTI interrupt) if these are enabled.
+     */
+    class Mpu6050Sim final
+    {
+    public:
+      /* Simulated MPU6050 constructor.
+       *
+       * Arguments:
+       *   uint32_t number -- sensor number for motion source
+       *   I2C_TypeDef *bus -- I2C bus
+       *   uint16_t address -- device address (shifted, as in HAL)
+       *   uint16_t intPin -- EXTI pin connected to INT pin
+       */
+      Mpu6050Sim(uint32_t number, I2C_TypeDef *bus, uint16_t address, uint16_t intPin);
+
+      /* Find device on bus function.
+       *
+       * Arguments:
+       *   I2C_TypeDef *bus -- I2C bus
+       *   uint16_t address -- device address
+       *
+       * Returns:
+       *   Pointer to device, nullptr if there is no such device.
+       */
+      static Mpu6050Sim * find(I2C_TypeDef *bus, uint16_t address);
+
+      /* Read registers function.
+       *
+       * Arguments:
+       *   uint8_t reg -- first register
+       *   uint8_t *data -- read values
+       *   uint32_t size -- number of values
+       *
+       * Returns:
+       *   None.
+       */
+      void read(uint8_t reg, uint8_t *data, uint32_t size);
+
+      /* Write registers function.
+       *
+       * Arguments:
+       *   uint8_t reg -- first register
+       *   const uint8_t *data -- values to write
+       *   uint32_t size -- number of values
+       *
+       * Returns:
+       *   None.
+       */
+      void write(uint8_t reg, const uint8_t *data, uint32_t size);
+
+    private:
+      static constexpr const uint32_t
+        REGS_COUNT = 128,  // Number of registers
+        FIFO_SIZE = 1024;  // Size of FIFO
+
+      uint32_t number;       // sensor number
+      I2C_TypeDef *bus;      // I2C bus
+      uint16_t address;      // device address
+      uint16_t intPin;       // EXTI pin connected to INT pin
+      uint8_t regs[REGS_COUNT]; // registers
+      std::deque<uint8_t> fifo; // FIFO data
+      bool isSampling = false;  // samples are being made
+
+      /* Reset registers function.
+       *
+       * Arguments:
+       *   None.
+       *
+       * Returns:
+       *   None.
+       */
+      void reset();
+
+      /* Make sample function.
+       * It is run by timer of device while it is not sleeping.
+       *
+       * Arguments:
+       *   None.
+       *
+       * Returns:
+       *   None.
+       */
+      void sample();
+
+      /* Time between samples getter.
+       *
+       * Arguments:
+       *   None.
+       *
+       * Returns:
+       *   Sampling period (CPU cycles).
+       */
+      Cycles getSamplePeriod() const;
+    }; // End of 'Mpu6050Sim' class
+  } // end of 'host' namespace
+} // end of 'mthl' namespace
+
+#endif // __MPU6050_SIM_H_
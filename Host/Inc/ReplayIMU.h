@@ -0,0 +1,126 @@
+/******************************
+ * File name   : ReplayIMU.h
+ * Purpose     : Mithril project.
+ *               Host build module.
+ *               IMU-sensor replaying recorded trace declaration
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __REPLAY_IMU_H_
+#define __REPLAY_IMU_H_
+
+#include "Sensors/MCU6050.h"
+#include "Trace.h"
+
+/* Mithril namespace */
+namespace mthl
+{
+  /* Replayed IMU-sensor class declaration.
+   * Raw bursts of recorded MPU6050 are decoded and filtered by MCU6050 code,
+   * so replay gives the same angles as device did. Calibration stored on
+   * device at recording is used, sensor is not calibrated again.
+   */
+  class ReplayIMU final : public MCU6050
+  {
+  public:
+    /* Replayed IMU-sensor constructor.
+     *
+     * Arguments:
+     *   const trace::SensorInfo &info -- sensor description from trace
+     */
+    explicit ReplayIMU(const trace::SensorInfo &info);
+
+    /* Pass recorded burst to sensor function.
+     * Burst is filtered by next 'update', as sample read with DMA.
+     *
+     * Arguments:
+     *   const trace::Record &record -- trace record of sensor
+     *
+     * Returns:
+     *   None.
+     */
+    void push(const trace::Record &record);
+
+    /* Read data from accelerometer
+     *
+     * Arguments:
+     *   math::quater &v -- quaternion to store data
+     *
+     * Returns:
+     *   None.
+     */
+    void readAccel(math::quater<float> &v) override;
+
+    /* Read data from gyroscope
+     *
+     * Arguments:
+     *   math::vec &v -- quaternion to store data
+     *
+     * Returns:
+     *   None.
+     */
+    void readGyro(math::quater<float> &v) override;
+
+    /* Read accelerometer, temperature and gyroscope data at once.
+     * Last pushed burst is read.
+     *
+     * Arguments:
+     *   Sample &s -- sample to store data
+     *
+     * Returns:
+     *   None.
+     */
+    void readMotion(Sample &s) override;
+
+    /* Calibrate device.
+     * Calibration recorded in trace is restored.
+     *
+     * Arguments:
+     *   int32_t iterations -- not used
+     *
+     * Returns:
+     *   true.
+     */
+    bool calibrate(int32_t iterations) override;
+
+    /* Sensor identity getter.
+     *
+     * Arguments:
+     *   None.
+     *
+     * Returns:
+     *   Identity of recorded sensor.
+     */
+    uint32_t getId() override;
+
+    /* Set sampling period function.
+     * Period is given by trace and can't be changed.
+     *
+     * Arguments:
+     *   uint32_t period -- sampling period (milliseconds)
+     *
+     * Returns:
+     *   false.
+     */
+    bool setSamplePeriod(uint32_t period) override;
+
+    /* Convert trace time to timer cycles function.
+     *
+     * Arguments:
+     *   uint64_t time -- time since session start (microseconds)
+     *
+     * Returns:
+     *   Timer cycles, they wrap as cycle counter of device.
+     */
+    static uint32_t toCycles(uint64_t time);
+
+  private:
+    trace::SensorInfo info;                       // description of recorded sensor
+    uint8_t lastBurst[MOTION_DATA_SIZE] = {};     // last pushed burst
+    uint32_t lastTime = 0;                        // time of last pushed burst (timer cycles)
+  }; // End of 'ReplayIMU' class
+} // end of 'mthl' namespace
+
+#endif // __REPLAY_IMU_H_
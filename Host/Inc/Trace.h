@@ -0,0 +1,161 @@
+/******************************
+ * File name   : Trace.h
+ * Purpose     : Mithril project.
+ *               Host build module.
+ *               Recorded IMU-sensors trace format declaration
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __TRACE_H_
+#define __TRACE_H_
+
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+#include "Sensors/MCU6050.h"
+
+/* Mithril namespace */
+namespace mthl
+{
+  /* IMU-sensors trace namespace.
+   * Trace is a file with session of wearer: raw MPU6050 register bursts of every
+   * sensor with times they were read. All numbers are little endian.
+   *   Header                         -- magic "MTRC", version, number of sensors
+   *   SensorInfo x number of sensors -- identity and calibration stored on device
+   *   Record ...                     -- bursts in order of time
+   */
+  namespace trace
+  {
+    static constexpr const uint16_t VERSION = 1; // Trace format version
+
+    /* Trace header structure */
+    struct Header
+    {
+      char magic[4];         // "MTRC"
+      uint16_t version;      // VERSION
+      uint16_t sensorsCount; // number of sensors
+    }; // End of 'Header' structure
+
+    /* Sensor description structure */
+    struct SensorInfo
+    {
+      uint32_t id;         // sensor identity (as 'IMU::getId' gives)
+      uint32_t reserved;   // zero
+      float gyroBias[3];   // gyroscope bias (degrees per second)
+      float angles[3];     // reference angles (degrees)
+    }; // End of 'SensorInfo' structure
+
+    /* Sensor data record structure */
+    struct Record
+    {
+      uint64_t time;   // time of reading since session start (microseconds)
+      uint8_t sensor;  // number of sensor in trace
+      uint8_t reserved; // zero
+      uint8_t burst[MCU6050::MOTION_DATA_SIZE]; // registers from ACCEL_XOUT_H to GYRO_ZOUT_L
+    }; // End of 'Record' structure
+
+    static_assert(sizeof(Header) == 8 && sizeof(SensorInfo) == 32 && sizeof(Record) == 24,
+        "Trace structures must have no padding");
+
+    /* Trace reader class declaration */
+    class Reader final
+    {
+    public:
+      /* Reader constructor.
+       *
+       * Arguments:
+       *   const char *path -- trace file
+       */
+      explicit Reader(const char *path);
+
+      Reader(const Reader &) = delete;
+      Reader & operator=(const Reader &) = delete;
+
+      ~Reader();
+
+      /* Trace validity getter.
+       *
+       * Arguments:
+       *   None.
+       *
+       * Returns:
+       *   true if file is opened and has correct header.
+       */
+      bool isValid() const;
+
+      /* Sensors descriptions getter.
+       *
+       * Arguments:
+       *   None.
+       *
+       * Returns:
+       *   Descriptions of trace sensors.
+       */
+      const std::vector<SensorInfo> & getSensors() const;
+
+      /* Read next record function.
+       *
+       * Arguments:
+       *   Record &record -- record to store data
+       *
+       * Returns:
+       *   false at the end of trace.
+       */
+      bool read(Record &record);
+
+    private:
+      FILE *file = nullptr;            // trace file
+      std::vector<SensorInfo> sensors; // sensors descriptions
+      std::vector<Record> buffer;      // records read from file
+      size_t position = 0;             // next record in buffer
+
+      static constexpr const size_t BUFFER_RECORDS = 4096; // Records read at once
+    }; // End of 'Reader' class
+
+    /* Trace writer class declaration */
+    class Writer final
+    {
+    public:
+      /* Writer constructor.
+       *
+       * Arguments:
+       *   const char *path -- trace file
+       *   const std::vector<SensorInfo> &sensors -- sensors descriptions
+       */
+      Writer(const char *path, const std::vector<SensorInfo> &sensors);
+
+      Writer(const Writer &) = delete;
+      Writer & operator=(const Writer &) = delete;
+
+      ~Writer();
+
+      /* Writer validity getter.
+       *
+       * Arguments:
+       *   None.
+       *
+       * Returns:
+       *   true if file is opened.
+       */
+      bool isValid() const;
+
+      /* Write record function.
+       *
+       * Arguments:
+       *   const Record &record -- record
+       *
+       * Returns:
+       *   None.
+       */
+      void write(const Record &record);
+
+    private:
+      FILE *file = nullptr; // trace file
+    }; // End of 'Writer' class
+  } // end of 'trace' namespace
+} // end of 'mthl' namespace
+
+#endif // __TRACE_H_
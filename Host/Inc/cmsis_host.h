@@ -0,0 +1,97 @@
+/******************************
+ * File name   : cmsis_host.h
+ * Purpose     : Mithril project.
+ *               Host build module.
+ *               CMSIS compiler intrinsics for host build
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __CMSIS_HOST_H_
+#define __CMSIS_HOST_H_
+
+/* This header is included before every source of host build. It takes place of
+ * cmsis_gcc.h, so Cortex-M instructions (interrupts masking, sleep) become calls
+ * to the simulator (HostSim.cpp) instead of ARM assembly.
+ */
+#define __CMSIS_GCC_H
+
+#include <stdint.h>
+
+#define __ASM                                  __asm
+#define __INLINE                               inline
+#define __STATIC_INLINE                        static inline
+#define __STATIC_FORCEINLINE                   __attribute__((always_inline)) static inline
+#define __NO_RETURN                            __attribute__((__noreturn__))
+#define __USED                                 __attribute__((used))
+#define __WEAK                                 __attribute__((weak))
+#define __PACKED                               __attribute__((packed, aligned(1)))
+#define __PACKED_STRUCT                        struct __attribute__((packed, aligned(1)))
+#define __PACKED_UNION                         union __attribute__((packed, aligned(1)))
+#define __ALIGNED(x)                           __attribute__((aligned(x)))
+#define __RESTRICT                             __restrict
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Interrupts and sleep are simulated (HostSim.cpp) */
+void __enable_irq(void);
+void __disable_irq(void);
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t priMask);
+uint32_t __get_IPSR(void);
+void __WFI(void);
+void __WFE(void);
+void __SEV(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+/* Barriers only keep compiler from reordering memory accesses */
+__STATIC_FORCEINLINE void __NOP(void)
+{
+}
+
+__STATIC_FORCEINLINE void __DSB(void)
+{
+  __ASM volatile ("" : : : "memory");
+}
+
+__STATIC_FORCEINLINE void __ISB(void)
+{
+  __ASM volatile ("" : : : "memory");
+}
+
+__STATIC_FORCEINLINE void __DMB(void)
+{
+  __ASM volatile ("" : : : "memory");
+}
+
+__STATIC_FORCEINLINE uint32_t __REV(uint32_t value)
+{
+  return __builtin_bswap32(value);
+}
+
+__STATIC_FORCEINLINE uint32_t __REV16(uint32_t value)
+{
+  return (value & 0xFF00FF00UL) >> 8 | (value & 0x00FF00FFUL) << 8;
+}
+
+__STATIC_FORCEINLINE uint32_t __RBIT(uint32_t value)
+{
+  uint32_t result = 0;
+
+  for (int i = 0; i < 32; ++i, value >>= 1)
+    result = result << 1 | (value & 1);
+  return result;
+}
+
+__STATIC_FORCEINLINE uint8_t __CLZ(uint32_t value)
+{
+  return value == 0 ? 32 : (uint8_t)__builtin_clz(value);
+}
+
+#endif /* __CMSIS_HOST_H_ */
@@ -0,0 +1,20 @@
+/******************************
+ * File name   : stm32f4xx_hal_conf.h
+ * Purpose     : Mithril project.
+ *               Host build module.
+ *               HAL configuration of host build
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#ifndef __HOST_HAL_CONF_H_
+#define __HOST_HAL_CONF_H_
+
+/* Host build is configured as firmware. This header is found before firmware one,
+ * includes it and then moves Cortex-M core peripherals to host memory (HostCore.h).
+ */
+#include "../../Core/Inc/stm32f4xx_hal_conf.h"
+#include "HostCore.h"
+
+#endif /* __HOST_HAL_CONF_H_ */
@@ -0,0 +1,135 @@
+/******************************
+ * File name   : BenchMain.cpp
+ * Purpose     : Mithril project.
+ *               Host build module.
+ *               Math microbenchmarks run and comparison with baseline
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Bench.h"
+
+namespace
+{
+  const char USAGE[] =
+    "usage: mithril_bench [--iterations N] [--baseline CSV] [--tolerance PERCENT]\n"
+    "Vector, quaternion and filters benchmarks results are printed as CSV (see Core/Inc/Bench.h).\n"
+    "With --baseline results are compared with saved output of mithril_bench or of\n"
+    "device 'B' command, exit status is 1 if some operation got slower than tolerance.\n";
+
+  /* Benchmark settings structure */
+  struct Settings
+  {
+    uint32_t iterations = 1000000;   // operations per run
+    const char *baseline = nullptr;  // CSV of previous results
+    double tolerance = 10;           // allowed slow down (percents)
+  }; // End of 'Settings' structure
+
+  /* Baseline result structure */
+  struct Baseline
+  {
+    std::string name, type, unit; // operation, number type and ticks unit
+    double perOp;                 // ticks per operation
+  }; // End of 'Baseline' structure
+
+  /* Read baseline results function.
+   * Lines which are not results (header, device messages) are skipped.
+   *
+   * Arguments:
+   *   const char *path -- CSV file
+   *   std::vector<Baseline> &results -- results to fill
+   *
+   * Returns:
+   *   true if file is read, false otherwise.
+   */
+  bool readBaseline(const char *path, std::vector<Baseline> &results)
+  {
+    FILE *file = fopen(path, "r");
+    char line[256], name[64], type[32], unit[16];
+    unsigned iterations, ticks;
+    double perOp;
+
+    if (file == nullptr)
+      return false;
+    while (fgets(line, sizeof(line), file) != nullptr)
+      if (sscanf(line, "%63[^,],%31[^,],%u,%u,%lf,%15[a-z]", name, type, &iterations, &ticks, &perOp, unit) == 6)
+        results.push_back({name, type, unit, perOp});
+    fclose(file);
+    return true;
+  } // End of 'readBaseline' function
+
+  /* Run benchmarks function.
+   *
+   * Arguments:
+   *   const Settings &settings -- benchmark settings
+   *
+   * Returns:
+   *   Exit status of program.
+   */
+  int runBenchmarks(const Settings &settings)
+  {
+    std::vector<Baseline> baseline;
+    int regressions = 0;
+
+    if (settings.baseline != nullptr && !readBaseline(settings.baseline, baseline))
+    {
+      fprintf(stderr, "Can't read baseline %s\n", settings.baseline);
+      return 2;
+    }
+
+    printf("name,type,iterations,ticks,per_op,unit\n");
+    for (uint32_t i = 0; i < mthl::bench::getCount(); ++i)
+    {
+      mthl::bench::Result result = mthl::bench::run(i, settings.iterations);
+      double perOp = static_cast<double>(result.ticks) / result.iterations;
+
+      printf("%s,%s,%u,%u,%.2f,%s\n", result.name, result.type, result.iterations, result.ticks, perOp,
+          mthl::bench::getUnit());
+      fflush(stdout);
+
+      // Results of other clock (device or host) are not comparable
+      for (const Baseline &base : baseline)
+        if (base.name == result.name && base.type == result.type && base.unit == mthl::bench::getUnit())
+        {
+          double change = (perOp / base.perOp - 1) * 100;
+
+          if (change > settings.tolerance)
+          {
+            fprintf(stderr, "Regression: %s %s %.2f -> %.2f %s (%+.1f %%)\n", result.name, result.type,
+                base.perOp, perOp, mthl::bench::getUnit(), change);
+            ++regressions;
+          }
+        }
+    }
+    if (settings.baseline != nullptr)
+      fprintf(stderr, "Regressions: %d (tolerance %.1f %%)\n", regressions, settings.tolerance);
+    return regressions == 0 ? 0 : 1;
+  } // End of 'runBenchmarks' function
+}
+
+/* Program entry point */
+int main(int argc, char *argv[])
+{
+  Settings settings;
+
+  for (int i = 1; i < argc; ++i)
+    if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0)
+      settings.iterations = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc)
+      settings.baseline = argv[++i];
+    else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc)
+      settings.tolerance = atof(argv[++i]);
+    else
+    {
+      fputs(USAGE, stderr);
+      return 2;
+    }
+  return runBenchmarks(settings);
+} // End of 'main' function
@@ -0,0 +1,540 @@
+/******************************
+ * File name   : HostHal.cpp
+ * Purpose     : Mithril project.
+ *               Host build module.
+ *               HAL functions implemented by simulated peripherals
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+
+#include "main.h"
+#include "HostSim.h"
+#include "Mpu6050Sim.h"
+
+/* UART handler 6 (for bluetooth) */
+extern UART_HandleTypeDef huart6;
+
+/* Tick variables of HAL */
+__IO uint32_t uwTick;
+uint32_t uwTickPrio = (1UL << __NVIC_PRIO_BITS);
+HAL_TickFreqTypeDef uwTickFreq = HAL_TICK_FREQ_DEFAULT;
+
+namespace
+{
+  /* Simulated UART state structure */
+  struct UartState
+  {
+    std::vector<uint8_t> output;  // transmitted bytes
+    std::deque<uint8_t> input;    // received bytes when DMA reception is stopped
+    uint8_t *rxBuffer = nullptr;  // DMA reception buffer
+    uint16_t rxSize = 0;          // size of DMA reception buffer
+    uint16_t rxPosition = 0;      // position of next received byte in buffer
+    mthl::host::Cycles rxLineFree = 0; // time when receiving line is free
+  };
+
+  const mthl::host::Cycles
+    FLASH_PROGRAM_CYCLES = 16 * 16; // Time of word programming (16 microseconds)
+  const double
+    SECTOR_ERASE_US_PER_KB = 8000;  // Time of sector erasing per kilobyte (1 second for 128K)
+
+  std::map<UART_HandleTypeDef *, UartState> uarts; // simulated UARTs
+  bool isFlashLocked = true;                       // is flash locked for programming
+
+  /* Time of UART byte getter.
+   *
+   * Arguments:
+   *   UART_HandleTypeDef *huart -- UART
+   *
+   * Returns:
+   *   Time of start bit, 8 data bits and stop bit.
+   */
+  mthl::host::Cycles getByteTime(UART_HandleTypeDef *huart)
+  {
+    return mthl::host::fromMicroseconds(10e6 / huart->Init.BaudRate);
+  } // End of 'getByteTime' function
+
+  /* Put transmitted bytes to UART output function.
+   * Debug output is printed right away.
+   *
+   * Arguments:
+   *   UART_HandleTypeDef *huart -- UART
+   *   const uint8_t *data -- bytes
+   *   uint16_t size -- number of bytes
+   *
+   * Returns:
+   *   None.
+   */
+  void putOutput(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t size)
+  {
+    auto &output = uarts[huart].output;
+
+    output.insert(output.end(), data, data + size);
+    if (huart->Instance == USART2)
+      fwrite(data, 1, size, stdout);
+  } // End of 'putOutput' function
+
+  /* Receive byte from line function.
+   *
+   * Arguments:
+   *   UART_HandleTypeDef *huart -- UART
+   *   uint8_t byte -- received byte
+   *
+   * Returns:
+   *   None.
+   */
+  void receiveByte(UART_HandleTypeDef *huart, uint8_t byte)
+  {
+    UartState &uart = uarts[huart];
+
+    if (huart->RxState != HAL_UART_STATE_BUSY_RX || uart.rxBuffer == nullptr)
+    {
+      uart.input.push_back(byte);
+      return;
+    }
+
+    bool isCircular = huart->hdmarx->Init.Mode == DMA_CIRCULAR;
+
+    uart.rxBuffer[uart.rxPosition++] = byte;
+    huart->hdmarx->Instance->NDTR = uart.rxSize - uart.rxPosition;
+    if (uart.rxPosition == uart.rxSize / 2)
+      HAL_UART_RxHalfCpltCallback(huart);
+    if (uart.rxPosition == uart.rxSize)
+    {
+      uart.rxPosition = 0;
+      if (isCircular)
+        huart->hdmarx->Instance->NDTR = uart.rxSize;
+      else
+      {
+        uart.rxBuffer = nullptr;
+        huart->RxState = HAL_UART_STATE_READY;
+      }
+      HAL_UART_RxCpltCallback(huart);
+    }
+  } // End of 'receiveByte' function
+
+  /* Time of I2C memory transfer getter.
+   *
+   * Arguments:
+   *   I2C_HandleTypeDef *hi2c -- I2C bus
+   *   uint16_t size -- number of data bytes
+   *   bool isRead -- is it reading (address is sent twice)
+   *
+   * Returns:
+   *   Time of transfer of address, register and data bytes (9 bits each).
+   */
+  mthl::host::Cycles getI2CTime(I2C_HandleTypeDef *hi2c, uint16_t size, bool isRead)
+  {
+    return mthl::host::fromMicroseconds(9e6 * (size + (isRead ? 3 : 2)) / hi2c->Init.ClockSpeed);
+  } // End of 'getI2CTime' function
+
+  /* Save application link output function.
+   *
+   * Arguments:
+   *   None.
+   *
+   * Returns:
+   *   None.
+   */
+  void saveLinkOutput()
+  {
+    const char *path = getenv("MITHRIL_SIM_UART6");
+    FILE *file = path == nullptr ? nullptr : fopen(path, "wb");
+
+    if (file == nullptr)
+      return;
+
+    auto &output = uarts[&huart6].output;
+
+    fwrite(output.data(), 1, output.size(), file);
+    fclose(file);
+  } // End of 'saveLinkOutput' function
+
+  /* Schedule input script function.
+   *
+   * Arguments:
+   *   const char *path -- script file
+   *
+   * Returns:
+   *   None.
+   */
+  void loadInput(const char *path)
+  {
+    FILE *file = fopen(path, "r");
+    char line[512];
+
+    if (file == nullptr)
+    {
+      fprintf(stderr, "mithril_host: can't open %s\n", path);
+      exit(2);
+    }
+
+    while (fgets(line, sizeof(line), file) != nullptr)
+    {
+      if (char *comment = strchr(line, '#'))
+        *comment = 0;
+
+      char *pos = line;
+      double time = strtod(line, &pos);
+      std::vector<uint8_t> data;
+      unsigned int byte;
+      int len;
+
+      if (pos == line)
+        continue;
+      while (sscanf(pos, " %2x%n", &byte, &len) == 1)
+      {
+        data.push_back(byte);
+        pos += len;
+      }
+      mthl::host::schedule(mthl::host::fromMicroseconds(time * 1000),
+          [data]() { mthl::host::sendToUart(&huart6, data); });
+    }
+    fclose(file);
+  } // End of 'loadInput' function
+}
+
+/* Send bytes to UART receiver function */
+void mthl::host::sendToUart(UART_HandleTypeDef *huart, const std::vector<uint8_t> &data)
+{
+  UartState &uart = uarts[huart];
+  Cycles
+    byteTime = getByteTime(huart),
+    start = uart.rxLineFree > getTime() ? uart.rxLineFree - getTime() : 0;
+
+  for (uint32_t i = 0; i < data.size(); ++i)
+  {
+    uint8_t byte = data[i];
+
+    schedule(start + (i + 1) * byteTime, [huart, byte]() { receiveByte(huart, byte); });
+  }
+  // Line is idle for one byte time after data
+  schedule(start + (data.size() + 1) * byteTime, [huart]()
+  {
+    if ((huart->Instance->CR1 & USART_CR1_IDLEIE) != 0)
+      UART_IdleCallback(huart);
+  });
+  uart.rxLineFree = getTime() + start + data.size() * byteTime;
+} // End of 'mthl::host::sendToUart' function
+
+/* Bytes sent by UART getter */
+const std::vector<uint8_t> & mthl::host::getUartOutput(UART_HandleTypeDef *huart)
+{
+  return uarts[huart].output;
+} // End of 'mthl::host::getUartOutput' function
+
+/* HAL initialization function */
+HAL_StatusTypeDef HAL_Init(void)
+{
+  // SysTick counts milliseconds
+  SysTick->LOAD = SystemCoreClock / 1000 - 1;
+  SysTick->VAL = 0;
+  SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+  HAL_MspInit();
+
+  if (const char *input = getenv("MITHRIL_SIM_INPUT"))
+    loadInput(input);
+  atexit(saveLinkOutput);
+  return HAL_OK;
+} // End of 'HAL_Init' function
+
+/* Tick counter increment function */
+void HAL_IncTick(void)
+{
+  uwTick += uwTickFreq;
+} // End of 'HAL_IncTick' function
+
+/* Clocks are always configured */
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *)
+{
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *, uint32_t)
+{
+  return HAL_OK;
+}
+
+/* Priorities are equal, enabled interrupts are marked in NVIC registers */
+void HAL_NVIC_SetPriority(IRQn_Type, uint32_t, uint32_t)
+{
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+  NVIC->ISER[IRQn >> 5] |= 1UL << (IRQn & 0x1F);
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+  NVIC->ISER[IRQn >> 5] &= ~(1UL << (IRQn & 0x1F));
+}
+
+/* DMA streams are simulated by peripherals */
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *)
+{
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_DeInit(DMA_HandleTypeDef *)
+{
+  return HAL_OK;
+}
+
+/* GPIO pins keep output values only */
+void HAL_GPIO_Init(GPIO_TypeDef *, GPIO_InitTypeDef *)
+{
+}
+
+void HAL_GPIO_DeInit(GPIO_TypeDef *, uint32_t)
+{
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+  if (PinState == GPIO_PIN_SET)
+    GPIOx->ODR |= GPIO_Pin;
+  else
+    GPIOx->ODR &= ~GPIO_Pin;
+}
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+  GPIOx->ODR ^= GPIO_Pin;
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+  return (GPIOx->IDR & GPIO_Pin) != 0 ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+/* UART initialization function */
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart)
+{
+  HAL_UART_MspInit(huart);
+  huart->ErrorCode = HAL_UART_ERROR_NONE;
+  huart->gState = HAL_UART_STATE_READY;
+  huart->RxState = HAL_UART_STATE_READY;
+  uarts[huart];
+  return HAL_OK;
+} // End of 'HAL_UART_Init' function
+
+/* UART blocking transmission function */
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size,
+    uint32_t)
+{
+  if (huart->gState != HAL_UART_STATE_READY)
+    return HAL_BUSY;
+  huart->gState = HAL_UART_STATE_BUSY_TX;
+  mthl::host::advance(Size * getByteTime(huart));
+  putOutput(huart, pData, Size);
+  huart->gState = HAL_UART_STATE_READY;
+  return HAL_OK;
+} // End of 'HAL_UART_Transmit' function
+
+/* UART DMA transmission function */
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+  if (huart->gState != HAL_UART_STATE_READY)
+    return HAL_BUSY;
+  huart->gState = HAL_UART_STATE_BUSY_TX;
+
+  std::vector<uint8_t> data(pData, pData + Size);
+
+  mthl::host::schedule(Size * getByteTime(huart), [huart, data]()
+  {
+    putOutput(huart, data.data(), data.size());
+    huart->gState = HAL_UART_STATE_READY;
+    HAL_UART_TxCpltCallback(huart);
+  });
+  return HAL_OK;
+} // End of 'HAL_UART_Transmit_DMA' function
+
+/* UART blocking reception function */
+HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size,
+    uint32_t Timeout)
+{
+  if (huart->RxState != HAL_UART_STATE_READY)
+    return HAL_BUSY;
+
+  UartState &uart = uarts[huart];
+  uint32_t start = HAL_GetTick();
+
+  for (uint16_t i = 0; i < Size; ++i)
+  {
+    while (uart.input.empty())
+    {
+      if (HAL_GetTick() - start >= Timeout)
+        return HAL_TIMEOUT;
+      __WFI();
+    }
+    pData[i] = uart.input.front();
+    uart.input.pop_front();
+  }
+  return HAL_OK;
+} // End of 'HAL_UART_Receive' function
+
+/* UART DMA reception function */
+HAL_StatusTypeDef HAL_UART_Receive_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+  if (huart->RxState != HAL_UART_STATE_READY)
+    return HAL_BUSY;
+
+  UartState &uart = uarts[huart];
+
+  huart->RxState = HAL_UART_STATE_BUSY_RX;
+  uart.rxBuffer = pData;
+  uart.rxSize = Size;
+  uart.rxPosition = 0;
+  huart->hdmarx->Instance->NDTR = Size;
+  return HAL_OK;
+} // End of 'HAL_UART_Receive_DMA' function
+
+/* I2C initialization function */
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c)
+{
+  HAL_I2C_MspInit(hi2c);
+  hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+  hi2c->State = HAL_I2C_STATE_READY;
+  return HAL_OK;
+} // End of 'HAL_I2C_Init' function
+
+/* I2C blocking memory reading function */
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+    uint16_t, uint8_t *pData, uint16_t Size, uint32_t)
+{
+  if (hi2c->State != HAL_I2C_STATE_READY)
+    return HAL_BUSY;
+
+  auto *device = mthl::host::Mpu6050Sim::find(hi2c->Instance, DevAddress);
+
+  hi2c->State = HAL_I2C_STATE_BUSY_RX;
+  mthl::host::advance(getI2CTime(hi2c, device != nullptr ? Size : 0, device != nullptr));
+  hi2c->State = HAL_I2C_STATE_READY;
+  if (device == nullptr)
+  {
+    hi2c->ErrorCode = HAL_I2C_ERROR_AF;
+    return HAL_ERROR;
+  }
+  device->read(MemAddress, pData, Size);
+  return HAL_OK;
+} // End of 'HAL_I2C_Mem_Read' function
+
+/* I2C blocking memory writing function */
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+    uint16_t, uint8_t *pData, uint16_t Size, uint32_t)
+{
+  if (hi2c->State != HAL_I2C_STATE_READY)
+    return HAL_BUSY;
+
+  auto *device = mthl::host::Mpu6050Sim::find(hi2c->Instance, DevAddress);
+
+  hi2c->State = HAL_I2C_STATE_BUSY_TX;
+  mthl::host::advance(getI2CTime(hi2c, device != nullptr ? Size : 0, false));
+  hi2c->State = HAL_I2C_STATE_READY;
+  if (device == nullptr)
+  {
+    hi2c->ErrorCode = HAL_I2C_ERROR_AF;
+    return HAL_ERROR;
+  }
+  device->write(MemAddress, pData, Size);
+  return HAL_OK;
+} // End of 'HAL_I2C_Mem_Write' function
+
+/* I2C DMA memory reading function */
+HAL_StatusTypeDef HAL_I2C_Mem_Read_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+    uint16_t, uint8_t *pData, uint16_t Size)
+{
+  if (hi2c->State != HAL_I2C_STATE_READY)
+    return HAL_BUSY;
+
+  auto *device = mthl::host::Mpu6050Sim::find(hi2c->Instance, DevAddress);
+
+  hi2c->State = HAL_I2C_STATE_BUSY_RX;
+  hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+  mthl::host::schedule(getI2CTime(hi2c, device != nullptr ? Size : 0, device != nullptr),
+      [=]()
+      {
+        hi2c->State = HAL_I2C_STATE_READY;
+        if (device == nullptr)
+        {
+          hi2c->ErrorCode = HAL_I2C_ERROR_AF;
+          HAL_I2C_ErrorCallback(hi2c);
+          return;
+        }
+        device->read(MemAddress, pData, Size);
+        HAL_I2C_MemRxCpltCallback(hi2c);
+      });
+  return HAL_OK;
+} // End of 'HAL_I2C_Mem_Read_DMA' function
+
+/* Flash unlocking function */
+HAL_StatusTypeDef HAL_FLASH_Unlock(void)
+{
+  isFlashLocked = false;
+  return HAL_OK;
+} // End of 'HAL_FLASH_Unlock' function
+
+/* Flash locking function */
+HAL_StatusTypeDef HAL_FLASH_Lock(void)
+{
+  isFlashLocked = true;
+  return HAL_OK;
+} // End of 'HAL_FLASH_Lock' function
+
+/* Flash programming function.
+ * Programming can only clear bits, as in real flash.
+ */
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data)
+{
+  uint32_t size = TypeProgram == FLASH_TYPEPROGRAM_BYTE ? 1 :
+    TypeProgram == FLASH_TYPEPROGRAM_HALFWORD ? 2 : TypeProgram == FLASH_TYPEPROGRAM_WORD ? 4 : 8;
+
+  if (isFlashLocked || Address < FLASH_BASE || Address + size > FLASH_END + 1)
+    return HAL_ERROR;
+
+  uint8_t *memory = reinterpret_cast<uint8_t *>(static_cast<uintptr_t>(Address));
+
+  for (uint32_t i = 0; i < size; ++i)
+    memory[i] &= Data >> 8 * i;
+  mthl::host::advance(FLASH_PROGRAM_CYCLES);
+  return HAL_OK;
+} // End of 'HAL_FLASH_Program' function
+
+/* Flash erasing function */
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError)
+{
+  // Sectors of STM32F411xE: 4 x 16K, 64K, 3 x 128K
+  static const uint32_t sectorSizes[] = {16, 16, 16, 16, 64, 128, 128, 128};
+
+  *SectorError = 0xFFFFFFFF;
+  if (isFlashLocked)
+    return HAL_ERROR;
+
+  uint32_t
+    first = pEraseInit->TypeErase == FLASH_TYPEERASE_MASSERASE ? 0 : pEraseInit->Sector,
+    count = pEraseInit->TypeErase == FLASH_TYPEERASE_MASSERASE ? 8 : pEraseInit->NbSectors;
+
+  for (uint32_t sector = first; sector < first + count; ++sector)
+  {
+    if (sector >= 8)
+    {
+      *SectorError = sector;
+      return HAL_ERROR;
+    }
+
+    uint32_t address = FLASH_BASE;
+
+    for (uint32_t i = 0; i < sector; ++i)
+      address += sectorSizes[i] * 1024;
+    memset(reinterpret_cast<void *>(static_cast<uintptr_t>(address)), 0xFF, sectorSizes[sector] * 1024);
+    mthl::host::advance(mthl::host::fromMicroseconds(SECTOR_ERASE_US_PER_KB * sectorSizes[sector]));
+  }
+  return HAL_OK;
+} // End of 'HAL_FLASHEx_Erase' function
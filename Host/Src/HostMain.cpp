@@ -0,0 +1,18 @@
+/******************************
+ * File name   : HostMain.cpp
+ * Purpose     : Mithril project.
+ *               Host build module.
+ *               Entry point of firmware run on simulated board
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+/* Firmware entry point (main.cpp) */
+int firmwareMain();
+
+/* Program entry point */
+int main()
+{
+  return firmwareMain();
+} // End of 'main' function
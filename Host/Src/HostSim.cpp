@@ -0,0 +1,445 @@
+/******************************
+ * File name   : HostSim.cpp
+ * Purpose     : Mithril project.
+ *               Host build module.
+ *               Virtual time, interrupts and memory of simulated board
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include <sys/mman.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <queue>
+
+#include "HostSim.h"
+
+namespace
+{
+  /* Memory region structure */
+  struct Region
+  {
+    uintptr_t address; // start address
+    size_t size;       // size in bytes
+    uint8_t fill;      // value after reset
+  };
+
+  /* Memory which is accessed by firmware by absolute addresses: flash (it is read by
+   * storages directly) and peripherals registers which are not simulated by HAL.
+   * Region addresses are out of host program and sanitizers memory.
+   */
+  const Region REGIONS[] =
+  {
+    {FLASH_BASE, 512 * 1024, 0xFF},
+    {PERIPH_BASE, 0x80000, 0x00}
+  };
+
+  const mthl::host::Cycles
+    POLL_CYCLES = 16; // Time of tick counter polling
+
+  /* Interrupt event structure */
+  struct Event
+  {
+    mthl::host::Cycles time;      // time of interrupt
+    uint64_t order;               // number of scheduling, events of same time come in this order
+    std::function<void()> handler; // interrupt handler
+
+    bool operator>(const Event &other) const
+    {
+      return time != other.time ? time > other.time : order > other.order;
+    }
+  };
+
+  /* SysTick timer state structure */
+  struct SysTickState
+  {
+    uint32_t ctrl = 0;       // ENABLE, TICKINT and CLKSOURCE bits
+    uint32_t load = 0;       // reload value
+    uint32_t value = 0;      // counter value at 'synced' time
+    bool countFlag = false;  // counter reached zero since last reading
+    mthl::host::Cycles synced = 0; // time of last counter update
+  };
+
+  mthl::host::Cycles
+    now = 0,                 // virtual time
+    endTime = 0,             // time to stop simulation
+    cycleCounterOffset = 0;  // time when DWT cycle counter was zero
+  uint64_t eventsCount = 0;  // number of scheduled events
+  std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events; // future interrupts
+  std::deque<std::function<void()>> pending; // interrupts which time has come
+  bool
+    isTickPending = false,   // SysTick interrupt is pending
+    isMasked = false,        // interrupts are disabled (PRIMASK)
+    isInHandler = false;     // interrupt handler is running
+  SysTickState sysTickState;
+  const char *flashImage = nullptr; // flash image file
+
+  /* Count passed SysTick cycles function.
+   *
+   * Arguments:
+   *   None.
+   *
+   * Returns:
+   *   None.
+   */
+  void syncSysTick()
+  {
+    mthl::host::Cycles elapsed = now - sysTickState.synced;
+
+    sysTickState.synced = now;
+    if ((sysTickState.ctrl & SysTick_CTRL_ENABLE_Msk) == 0)
+      return;
+
+    while (elapsed > 0 && (sysTickState.value != 0 || sysTickState.load != 0))
+    {
+      // Counter is reloaded on cycle after zero
+      if (sysTickState.value == 0)
+      {
+        sysTickState.value = sysTickState.load;
+        --elapsed;
+        continue;
+      }
+
+      mthl::host::Cycles step = elapsed < sysTickState.value ? elapsed : sysTickState.value;
+
+      sysTickState.value -= step;
+      elapsed -= step;
+      if (sysTickState.value == 0)
+      {
+        sysTickState.countFlag = true;
+        if ((sysTickState.ctrl & SysTick_CTRL_TICKINT_Msk) != 0)
+          isTickPending = true;
+      }
+    }
+  } // End of 'syncSysTick' function
+
+  /* Time of next SysTick counter zero getter.
+   *
+   * Arguments:
+   *   None.
+   *
+   * Returns:
+   *   Time of zero, UINT64_MAX if counter is stopped.
+   */
+  mthl::host::Cycles getNextSysTick()
+  {
+    if ((sysTickState.ctrl & SysTick_CTRL_ENABLE_Msk) == 0 ||
+        (sysTickState.value == 0 && sysTickState.load == 0))
+      return UINT64_MAX;
+    if (sysTickState.value == 0)
+      return now + 1 + sysTickState.load;
+    return now + sysTickState.value;
+  } // End of 'getNextSysTick' function
+
+  /* Move interrupts which time has come to pending function.
+   *
+   * Arguments:
+   *   None.
+   *
+   * Returns:
+   *   None.
+   */
+  void collectEvents()
+  {
+    while (!events.empty() && events.top().time <= now)
+    {
+      pending.push_back(events.top().handler);
+      events.pop();
+    }
+  } // End of 'collectEvents' function
+
+  /* Run pending interrupts function.
+   *
+   * Arguments:
+   *   None.
+   *
+   * Returns:
+   *   None.
+   */
+  void runInterrupts()
+  {
+    while (!isMasked && !isInHandler)
+    {
+      std::function<void()> handler;
+
+      if (isTickPending)
+      {
+        isTickPending = false;
+        handler = HAL_IncTick;
+      }
+      else if (!pending.empty())
+      {
+        handler = std::move(pending.front());
+        pending.pop_front();
+      }
+      else
+        break;
+
+      isInHandler = true;
+      handler();
+      isInHandler = false;
+    }
+  } // End of 'runInterrupts' function
+
+  /* Save flash image function.
+   *
+   * Arguments:
+   *   None.
+   *
+   * Returns:
+   *   None.
+   */
+  void saveFlash()
+  {
+    FILE *file = fopen(flashImage, "wb");
+
+    if (file == nullptr)
+      return;
+    fwrite(reinterpret_cast<const void *>(REGIONS[0].address), 1, REGIONS[0].size, file);
+    fclose(file);
+  } // End of 'saveFlash' function
+
+  /* Map board memory function.
+   * It is run before static constructors of firmware.
+   *
+   * Arguments:
+   *   None.
+   *
+   * Returns:
+   *   None.
+   */
+  __attribute__((constructor(101))) void mapMemory()
+  {
+    for (auto &region : REGIONS)
+    {
+      void *memory = mmap(reinterpret_cast<void *>(region.address), region.size,
+          PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+      if (memory != reinterpret_cast<void *>(region.address))
+      {
+        fprintf(stderr, "mithril_host: can't map memory at 0x%08lX\n", (unsigned long)region.address);
+        std::exit(2);
+      }
+      memset(memory, region.fill, region.size);
+    }
+
+    if ((flashImage = getenv("MITHRIL_SIM_FLASH")) != nullptr)
+    {
+      if (FILE *file = fopen(flashImage, "rb"))
+      {
+        size_t size = fread(reinterpret_cast<void *>(REGIONS[0].address), 1, REGIONS[0].size, file);
+
+        (void)size;
+        fclose(file);
+      }
+      atexit(saveFlash);
+    }
+
+    const char *time = getenv("MITHRIL_SIM_TIME");
+
+    endTime = mthl::host::fromMicroseconds((time != nullptr ? atof(time) : 10) * 1e6);
+  } // End of 'mapMemory' function
+}
+
+/* Core peripherals */
+mthl::host::SysTickRegisters mthl::host::sysTick;
+mthl::host::DwtRegisters mthl::host::dwt;
+SCB_Type mthl::host::scb{};
+NVIC_Type mthl::host::nvic{};
+CoreDebug_Type mthl::host::coreDebug{};
+DBGMCU_TypeDef mthl::host::dbgmcu{};
+
+/* Read SysTick register function */
+uint32_t mthl::host::readSysTick(SysTickField field)
+{
+  syncSysTick();
+  switch (field)
+  {
+  case SysTickField::CTRL:
+  {
+    // Count flag is cleared by reading
+    uint32_t value = sysTickState.ctrl | (sysTickState.countFlag ? SysTick_CTRL_COUNTFLAG_Msk : 0);
+
+    sysTickState.countFlag = false;
+    return value;
+  }
+  case SysTickField::LOAD:
+    return sysTickState.load;
+  case SysTickField::VAL:
+    return sysTickState.value;
+  default:
+    return SystemCoreClock / 8000 | SysTick_CALIB_NOREF_Msk;
+  }
+} // End of 'mthl::host::readSysTick' function
+
+/* Write SysTick register function */
+void mthl::host::writeSysTick(SysTickField field, uint32_t value)
+{
+  syncSysTick();
+  switch (field)
+  {
+  case SysTickField::CTRL:
+    sysTickState.ctrl = value & (SysTick_CTRL_ENABLE_Msk | SysTick_CTRL_TICKINT_Msk |
+        SysTick_CTRL_CLKSOURCE_Msk);
+    break;
+  case SysTickField::LOAD:
+    sysTickState.load = value & SysTick_LOAD_RELOAD_Msk;
+    break;
+  case SysTickField::VAL:
+    // Any writing clears counter and count flag
+    sysTickState.value = 0;
+    sysTickState.countFlag = false;
+    break;
+  default:
+    break;
+  }
+} // End of 'mthl::host::writeSysTick' function
+
+/* Cycle counter getter */
+uint32_t mthl::host::readCycleCounter()
+{
+  return static_cast<uint32_t>(now - cycleCounterOffset);
+} // End of 'mthl::host::readCycleCounter' function
+
+/* Cycle counter setter */
+void mthl::host::writeCycleCounter(uint32_t value)
+{
+  cycleCounterOffset = now - value;
+} // End of 'mthl::host::writeCycleCounter' function
+
+/* Virtual time getter */
+mthl::host::Cycles mthl::host::getTime()
+{
+  return now;
+} // End of 'mthl::host::getTime' function
+
+/* Convert microseconds to CPU cycles function */
+mthl::host::Cycles mthl::host::fromMicroseconds(double us)
+{
+  return static_cast<Cycles>(us * SystemCoreClock / 1e6 + 0.5);
+} // End of 'mthl::host::fromMicroseconds' function
+
+/* Pass virtual time function */
+void mthl::host::advance(Cycles cycles)
+{
+  Cycles target = now + cycles;
+
+  do
+  {
+    Cycles next = target, tick = getNextSysTick();
+
+    if (tick < next)
+      next = tick;
+    if (!events.empty() && events.top().time < next)
+      next = events.top().time;
+    if (next >= endTime)
+    {
+      now = endTime;
+      stop(0);
+    }
+
+    now = next;
+    syncSysTick();
+    collectEvents();
+    runInterrupts();
+  } while (now < target);
+} // End of 'mthl::host::advance' function
+
+/* Schedule interrupt function */
+void mthl::host::schedule(Cycles delay, std::function<void()> handler)
+{
+  events.push({now + delay, eventsCount++, std::move(handler)});
+} // End of 'mthl::host::schedule' function
+
+/* Stop simulation function */
+void mthl::host::stop(int code)
+{
+  fflush(stdout);
+  fprintf(stderr, "mithril_host: stopped at %.3f s\n", static_cast<double>(now) / SystemCoreClock);
+  std::exit(code);
+} // End of 'mthl::host::stop' function
+
+/* Enable interrupts function */
+void __enable_irq(void)
+{
+  isMasked = false;
+  runInterrupts();
+} // End of '__enable_irq' function
+
+/* Disable interrupts function */
+void __disable_irq(void)
+{
+  isMasked = true;
+} // End of '__disable_irq' function
+
+/* Interrupts mask getter */
+uint32_t __get_PRIMASK(void)
+{
+  return isMasked;
+} // End of '__get_PRIMASK' function
+
+/* Interrupts mask setter */
+void __set_PRIMASK(uint32_t priMask)
+{
+  if ((priMask & 1) != 0)
+    __disable_irq();
+  else
+    __enable_irq();
+} // End of '__set_PRIMASK' function
+
+/* Active exception number getter */
+uint32_t __get_IPSR(void)
+{
+  // Any peripheral interrupt, they are not distinguished
+  return isInHandler ? 16 : 0;
+} // End of '__get_IPSR' function
+
+/* Wait for interrupt function */
+void __WFI(void)
+{
+  syncSysTick();
+  collectEvents();
+  // Pending interrupt wakes CPU even if interrupts are masked
+  if (isTickPending || !pending.empty())
+  {
+    runInterrupts();
+    return;
+  }
+
+  mthl::host::Cycles next = getNextSysTick();
+
+  if (!events.empty() && events.top().time < next)
+    next = events.top().time;
+  if (next == UINT64_MAX)
+  {
+    fprintf(stderr, "mithril_host: CPU sleeps without wake up sources\n");
+    mthl::host::stop(1);
+  }
+  // Core clock is gated in sleep, cycle counter stops too
+  if ((mthl::host::dbgmcu.CR & DBGMCU_CR_DBG_SLEEP) == 0)
+    cycleCounterOffset += next - now;
+  mthl::host::advance(next - now);
+} // End of '__WFI' function
+
+/* Wait for event function */
+void __WFE(void)
+{
+  __WFI();
+} // End of '__WFE' function
+
+/* Send event function */
+void __SEV(void)
+{
+} // End of '__SEV' function
+
+/* Tick counter getter (overrides HAL one).
+ * Polling takes some time, so loops waiting for tick always finish.
+ */
+uint32_t HAL_GetTick(void)
+{
+  mthl::host::advance(POLL_CYCLES);
+  return uwTick;
+} // End of 'HAL_GetTick' function
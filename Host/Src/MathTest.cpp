@@ -0,0 +1,313 @@
+/******************************
+ * File name   : MathTest.cpp
+ * Purpose     : Mithril project.
+ *               Host build module.
+ *               Math library checks
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+
+#include "Math/fixed.h"
+#include "Math/quater.h"
+
+namespace
+{
+  const char USAGE[] =
+    "usage: mithril_math_test SUITE...\n"
+    "Suites: fastmath (fast functions against libm and their error bounds,\n"
+    "vec and quater of double keep double precision), quater (quaternion operations).\n";
+
+  using mthl::math::fixed;
+  using mthl::math::quater;
+  using mthl::math::vec;
+
+  int failures = 0; // number of failed checks
+
+  /* Check condition function.
+   *
+   * Arguments:
+   *   bool isOk -- checked condition
+   *   const char *what -- description of check
+   *
+   * Returns:
+   *   None.
+   */
+  void check(bool isOk, const char *what)
+  {
+    if (!isOk)
+    {
+      printf("FAILED: %s\n", what);
+      failures++;
+    }
+  } // End of 'check' function
+
+  /* Check maximal error against bound function.
+   *
+   * Arguments:
+   *   const char *name -- function and range
+   *   double error -- measured maximal error
+   *   float bound -- error bound
+   *
+   * Returns:
+   *   None.
+   */
+  void checkBound(const char *name, double error, float bound)
+  {
+    printf("%-24s max error %.3g (bound %.3g)\n", name, error, static_cast<double>(bound));
+    check(error <= static_cast<double>(bound), name);
+  } // End of 'checkBound' function
+
+  /* Error of fast function value function.
+   *
+   * Arguments:
+   *   float value -- fast function value
+   *   double exact -- library function value
+   *
+   * Returns:
+   *   Absolute error.
+   */
+  double getError(float value, double exact)
+  {
+    return std::fabs(static_cast<double>(value) - exact);
+  } // End of 'getError' function
+
+  /* Sweep sine and cosine over range function.
+   *
+   * Arguments:
+   *   double range -- angles are in [-range, range]
+   *
+   * Returns:
+   *   Maximal error.
+   */
+  double sweepSinCos(double range)
+  {
+    const int32_t STEPS = 2000000;
+    double maxError = 0;
+
+    for (int32_t i = 0; i <= STEPS; ++i)
+    {
+      float x = static_cast<float>(-range + 2 * range * i / STEPS), s = 0, c = 0;
+
+      mthl::math::fastSinCos(x, s, c);
+      maxError = std::fmax(maxError, getError(s, std::sin(static_cast<double>(x))));
+      maxError = std::fmax(maxError, getError(c, std::cos(static_cast<double>(x))));
+    }
+    return maxError;
+  } // End of 'sweepSinCos' function
+
+  /* Fast functions checks function.
+   *
+   * Arguments:
+   *   None.
+   *
+   * Returns:
+   *   None.
+   */
+  void testFastmath()
+  {
+    // Arctangent: points on circles of different radii, all directions
+    double maxError = 0;
+
+    for (double radius : {1e-3, 1.0, 7.5, 1e4})
+      for (int32_t i = 0; i < 1000000; ++i)
+      {
+        double angle = 2 * M_PI * i / 1000000;
+        float
+          y = static_cast<float>(radius * std::sin(angle)),
+          x = static_cast<float>(radius * std::cos(angle));
+
+        maxError = std::fmax(maxError,
+            getError(mthl::math::fastAtan2(y, x), std::atan2(static_cast<double>(y), static_cast<double>(x))));
+      }
+    checkBound("fastAtan2", maxError, mthl::math::FAST_ATAN2_MAX_ERROR);
+    check(mthl::math::fastAtan2(0.0f, 0.0f) == 0, "fastAtan2(0, 0) == 0");
+
+    checkBound("fastSinCos [-10, 10]", sweepSinCos(10), 1.0e-6f);
+    checkBound("fastSinCos [-100, 100]", sweepSinCos(100), mthl::math::FAST_SINCOS_MAX_ERROR);
+
+    // Arccosine: whole domain, arguments out of it are clamped
+    maxError = 0;
+    for (int32_t i = 0; i <= 2000000; ++i)
+    {
+      float x = static_cast<float>(-1 + 2.0 * i / 2000000);
+
+      maxError = std::fmax(maxError, getError(mthl::math::fastAcos(x), std::acos(static_cast<double>(x))));
+    }
+    checkBound("fastAcos", maxError, mthl::math::FAST_ACOS_MAX_ERROR);
+    check(mthl::math::fastAcos(1.5f) == mthl::math::fastAcos(1.0f), "fastAcos clamps argument");
+
+    // Square root is exact
+    for (float x : {0.0f, 1e-20f, 0.25f, 2.0f, 1e20f})
+      check(mthl::math::fastSqrt(x) == std::sqrt(x), "fastSqrt is exact");
+    check(mthl::math::fastSqrt(-1.0f) == 0, "fastSqrt(-1) == 0");
+    // sqrt(2) * 65536 = 92681.9, result is truncated
+    check(mthl::math::fastSqrt(fixed(2)) == fixed::fromRaw(92681), "fastSqrt(fixed) is exact");
+
+    // Double vectors and quaternions are not truncated to float
+    double small = 1e-10;
+
+    check((!vec<double>(3, 4, 12)) == 13, "vec<double> length is exact");
+    check(std::fabs(!vec<double>(1 + small, 0, 0) - 1 - small) < 1e-15, "vec<double> length in double precision");
+
+    vec<double> euler = quater<double>::fromAxisAngle(vec<double>(1, 0, 0), 0.3 + small).toEuler();
+
+    check(std::fabs(euler[0] - 0.3 - small) < 1e-14, "quater<double> euler angles in double precision");
+    check(std::fabs(quater<double>::fromAxisAngle(vec<double>(0, 0, 1), 1 + small).arg() - (1 + small) / 2) < 1e-14,
+        "quater<double> argument in double precision");
+  } // End of 'testFastmath' function
+
+  /* Quaternion operations are constexpr */
+  static_assert((quater<float>(1, 2, 3, 4) * quater<float>(1, 2, 3, 4))[0] == -28, "constexpr multiplication");
+  static_assert((quater<fixed>(1, 2, 3, 4) * quater<fixed>(1, 2, 3, 4))[3] == 8, "constexpr fixed multiplication");
+  static_assert((quater<float>(2, 0, 0, 0) / quater<float>(2, 0, 0, 0))[0] == 1, "constexpr division");
+  static_assert(quater<float>(0, 0, 0, 1).rotate(vec<float>(1, 2, 3))[0] == -1, "constexpr rotation");
+  static_assert(quater<float>(1, 2, 3, 4).conjugate()[1] == -2, "constexpr conjugate");
+  static_assert(quater<float>::fromAxisAngle(vec<float>(0, 0, 1), 0)[0] == 1, "constexpr rotation creation");
+
+  /* Check quaternions are close function.
+   *
+   * Arguments:
+   *   const quater<float> &q1, &q2 -- quaternions
+   *   float tolerance -- maximal difference of coordinates
+   *
+   * Returns:
+   *   true if all coordinates differ less than tolerance.
+   */
+  bool isNear(const quater<float> &q1, const quater<float> &q2, float tolerance = 1e-5f)
+  {
+    for (int32_t i = 0; i < 4; ++i)
+      if (std::fabs(q1[i] - q2[i]) > tolerance)
+        return false;
+    return true;
+  } // End of 'isNear' function
+
+  /* Check vectors are close function.
+   *
+   * Arguments:
+   *   const vec<float> &v1, &v2 -- vectors
+   *   float tolerance -- maximal difference of coordinates
+   *
+   * Returns:
+   *   true if all coordinates differ less than tolerance.
+   */
+  bool isNear(const vec<float> &v1, const vec<float> &v2, float tolerance = 1e-5f)
+  {
+    for (int32_t i = 0; i < 3; ++i)
+      if (std::fabs(v1[i] - v2[i]) > tolerance)
+        return false;
+    return true;
+  } // End of 'isNear' function
+
+  /* Quaternion operations checks function.
+   *
+   * Arguments:
+   *   None.
+   *
+   * Returns:
+   *   None.
+   */
+  void testQuater()
+  {
+    // Product in place reads operands before it changes them
+    quater<float> q(1, 2, 3, 4), p = q;
+
+    q *= q;
+    check(isNear(q, quater<float>(-28, 4, 6, 8), 0), "self multiplication");
+    check(isNear(q, p * p, 0), "self multiplication equals product of copies");
+    p /= p;
+    check(isNear(p, quater<float>(1, 0, 0, 0)), "self division");
+
+    const vec<float> axes[] = {vec<float>(1, 0, 0), vec<float>(0, 0, 1), vec<float>(0.48f, -0.6f, 0.64f)};
+
+    for (const vec<float> &axis : axes)
+      for (float angle : {-2.5f, -0.3f, 0.0f, 1.0f, 3.0f})
+      {
+        quater<float> r = quater<float>::fromAxisAngle(axis, angle), w(0.5f, -1.0f, 2.0f, 0.25f);
+
+        check(isNear(r / r, quater<float>(1, 0, 0, 0)), "q / q == 1");
+        check(isNear(w * r / r, w), "w * q / q == w");
+        check(std::fabs(!r - 1) < 1e-6f, "rotation is unit quaternion");
+
+        // Rotation equals sandwich production q * v * q^-1
+        vec<float> v(0.3f, -2.0f, 1.5f);
+        quater<float> sandwich = r * quater<float>(0, v) * r.reciprocal();
+
+        check(isNear(r.rotate(v), vec<float>(sandwich[1], sandwich[2], sandwich[3])), "rotate equals q * v * q^-1");
+        check(std::fabs(r.arg() - std::fabs(angle) / 2) < 1e-4f, "argument is half of rotation angle");
+
+        // Interpolation from identity goes along the same axis with constant speed
+        quater<float> identity(1, 0, 0, 0);
+
+        check(isNear(quater<float>::slerp(identity, r, 0), identity), "slerp start");
+        check(isNear(quater<float>::slerp(identity, r, 1), r), "slerp end");
+        check(isNear(quater<float>::slerp(identity, r, 0.5f), quater<float>::fromAxisAngle(axis, angle / 2), 1e-4f),
+            "slerp middle");
+        check(isNear(quater<float>::slerp(identity, -r, 0.5f), quater<float>::fromAxisAngle(axis, angle / 2), 1e-4f),
+            "slerp goes by shortest arc");
+      }
+
+    // Euler angles of rotation yaw around z, pitch around y, roll around x
+    for (float roll : {-2.0f, 0.0f, 0.7f})
+      for (float pitch : {-1.2f, 0.0f, 0.4f})
+        for (float yaw : {-3.0f, 0.1f, 2.5f})
+        {
+          quater<float> r = quater<float>::fromAxisAngle(vec<float>(0, 0, 1), yaw) *
+            quater<float>::fromAxisAngle(vec<float>(0, 1, 0), pitch) *
+            quater<float>::fromAxisAngle(vec<float>(1, 0, 0), roll);
+
+          check(isNear(r.toEuler(), vec<float>(roll, pitch, yaw), 1e-4f), "Euler angles round trip");
+        }
+  } // End of 'testQuater' function
+
+  /* Test suite structure */
+  struct Suite
+  {
+    const char *name;    // suite name
+    void (*run)();       // checks function
+  }; // End of 'Suite' structure
+
+  const Suite SUITES[] =
+  {
+    {"fastmath", testFastmath},
+    {"quater", testQuater}
+  };
+}
+
+/* Program entry point */
+int main(int argc, char *argv[])
+{
+  if (argc < 2)
+  {
+    fputs(USAGE, stderr);
+    return 2;
+  }
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const Suite *suite = nullptr;
+
+    for (const Suite &s : SUITES)
+      if (strcmp(argv[i], s.name) == 0)
+        suite = &s;
+    if (suite == nullptr)
+    {
+      fprintf(stderr, "mithril_math_test: unknown suite '%s'\n%s", argv[i], USAGE);
+      return 2;
+    }
+    suite->run();
+  }
+
+  if (failures != 0)
+  {
+    printf("%d checks failed\n", failures);
+    return 1;
+  }
+  printf("All checks passed\n");
+  return 0;
+} // End of 'main' function
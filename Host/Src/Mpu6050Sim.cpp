@@ -0,0 +1,244 @@
+/******************************
+ * File name   : Mpu6050Sim.cpp
+ * Purpose     : Mithril project.
+ *               Host build module.
+ *               Simulated MPU6050 IMU-sensor class implementation
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include <cmath>
+#include <cstdlib>
+
+#include "Mpu6050Sim.h"
+#include "Sensors/MCU6050.h"
+
+namespace
+{
+  /* Registers numbers and bits */
+  const uint8_t
+    SMPLRT_DIV = 0x19, CONFIG = 0x1A, GYRO_CONFIG = 0x1B, ACCEL_CONFIG = 0x1C,
+    FIFO_EN = 0x23, INT_ENABLE = 0x38, INT_STATUS = 0x3A, ACCEL_XOUT_H = 0x3B,
+    USER_CTRL = 0x6A, PWR_MGMT_1 = 0x6B, FIFO_COUNTH = 0x72, FIFO_COUNTL = 0x73,
+    FIFO_R_W = 0x74, WHO_AM_I = 0x75, SIGNATURE = 0x68,
+    PWR_MGMT_1_RESET = 0x80, PWR_MGMT_1_SLEEP = 0x40,
+    USER_CTRL_FIFO_EN = 0x40, USER_CTRL_FIFO_RESET = 0x04,
+    INT_DATA_RDY = 0x01, INT_FIFO_OFLOW = 0x10,
+    FIFO_EN_ACCEL = 0x08, FIFO_EN_TEMP = 0x80;
+
+  /* Sensors lie still: gravity along Z axis (or tilted around Y axis by MITHRIL_SIM_TILT degrees
+   * starting from MITHRIL_SIM_TILT_TIME seconds), gyroscopes have small bias */
+  mthl::host::MotionSource motionSource = [](uint32_t sensor, double time)
+  {
+    static const char
+      *tiltSetting = getenv("MITHRIL_SIM_TILT"),
+      *tiltTimeSetting = getenv("MITHRIL_SIM_TILT_TIME");
+    static const float tilt = (tiltSetting != nullptr ? static_cast<float>(atof(tiltSetting)) : 0) * 3.14159265f / 180;
+    static const double tiltTime = tiltTimeSetting != nullptr ? atof(tiltTimeSetting) : 0;
+    float angle = time < tiltTime ? 0 : tilt;
+
+    return mthl::host::Motion{{std::sin(angle), 0, std::cos(angle)}, {0.5f + 0.25f * sensor, -0.3f, 0.1f}};
+  };
+
+  /* Board wiring, it is the same as in controller */
+  mthl::host::Mpu6050Sim devices[] =
+  {
+    {0, I2C1, mthl::MCU6050::MPU6050_ADDR_1, GPIO_PIN_0},
+    {1, I2C3, mthl::MCU6050::MPU6050_ADDR_1, GPIO_PIN_1},
+    {2, I2C1, mthl::MCU6050::MPU6050_ADDR_2, GPIO_PIN_2}
+  };
+
+  /* Convert value to register units function.
+   *
+   * Arguments:
+   *   float value -- physical value
+   *   float scale -- units per value unit
+   *
+   * Returns:
+   *   Value in units clamped to int16.
+   */
+  int16_t toUnits(float value, float scale)
+  {
+    float units = value * scale;
+
+    if (units >= 32767)
+      return 32767;
+    if (units <= -32768)
+      return -32768;
+    return static_cast<int16_t>(units < 0 ? units - 0.5f : units + 0.5f);
+  } // End of 'toUnits' function
+}
+
+/* Set motion of simulated IMU-sensors function */
+void mthl::host::setMotionSource(MotionSource source)
+{
+  motionSource = std::move(source);
+} // End of 'mthl::host::setMotionSource' function
+
+/* Simulated MPU6050 constructor */
+mthl::host::Mpu6050Sim::Mpu6050Sim(uint32_t number, I2C_TypeDef *bus, uint16_t address, uint16_t intPin)
+  : number(number), bus(bus), address(address), intPin(intPin)
+{
+  reset();
+} // End of 'mthl::host::Mpu6050Sim::Mpu6050Sim' constructor
+
+/* Find device on bus function */
+mthl::host::Mpu6050Sim * mthl::host::Mpu6050Sim::find(I2C_TypeDef *bus, uint16_t address)
+{
+  for (auto &device : devices)
+    if (device.bus == bus && device.address == address)
+      return &device;
+  return nullptr;
+} // End of 'mthl::host::Mpu6050Sim::find' function
+
+/* Read registers function */
+void mthl::host::Mpu6050Sim::read(uint8_t reg, uint8_t *data, uint32_t size)
+{
+  for (uint32_t i = 0; i < size; ++i)
+  {
+    // FIFO data register is not incremented
+    if (reg == FIFO_R_W)
+    {
+      data[i] = fifo.empty() ? 0 : fifo.front();
+      if (!fifo.empty())
+        fifo.pop_front();
+      continue;
+    }
+
+    if (reg == FIFO_COUNTH)
+      data[i] = fifo.size() >> 8;
+    else if (reg == FIFO_COUNTL)
+      data[i] = fifo.size() & 0xFF;
+    else
+      data[i] = regs[reg];
+    // Status is cleared by reading
+    if (reg == INT_STATUS)
+      regs[reg] = 0;
+    reg = (reg + 1) % REGS_COUNT;
+  }
+} // End of 'mthl::host::Mpu6050Sim::read' function
+
+/* Write registers function */
+void mthl::host::Mpu6050Sim::write(uint8_t reg, const uint8_t *data, uint32_t size)
+{
+  for (uint32_t i = 0; i < size; ++i, reg = (reg + 1) % REGS_COUNT)
+  {
+    if (reg == PWR_MGMT_1 && (data[i] & PWR_MGMT_1_RESET) != 0)
+    {
+      reset();
+      continue;
+    }
+    if (reg == USER_CTRL && (data[i] & USER_CTRL_FIFO_RESET) != 0)
+      fifo.clear();
+    if (reg == FIFO_R_W || reg == WHO_AM_I || reg == INT_STATUS)
+      continue;
+    regs[reg] = reg == USER_CTRL ? data[i] & ~USER_CTRL_FIFO_RESET : data[i];
+  }
+
+  // Sampling timer runs while device is awake
+  if (!isSampling && (regs[PWR_MGMT_1] & PWR_MGMT_1_SLEEP) == 0)
+  {
+    isSampling = true;
+    schedule(getSamplePeriod(), [this]() { sample(); });
+  }
+} // End of 'mthl::host::Mpu6050Sim::write' function
+
+/* Reset registers function */
+void mthl::host::Mpu6050Sim::reset()
+{
+  for (auto &reg : regs)
+    reg = 0;
+  regs[PWR_MGMT_1] = PWR_MGMT_1_SLEEP;
+  regs[WHO_AM_I] = SIGNATURE;
+  fifo.clear();
+} // End of 'mthl::host::Mpu6050Sim::reset' function
+
+/* Make sample function */
+void mthl::host::Mpu6050Sim::sample()
+{
+  if ((regs[PWR_MGMT_1] & PWR_MGMT_1_SLEEP) != 0)
+  {
+    isSampling = false;
+    return;
+  }
+  schedule(getSamplePeriod(), [this]() { sample(); });
+
+  Motion motion = motionSource(number, static_cast<double>(getTime()) / SystemCoreClock);
+  float
+    accelScale = 16384 >> (regs[ACCEL_CONFIG] >> 3 & 3),
+    gyroScale = 131.0f / (1 << (regs[GYRO_CONFIG] >> 3 & 3));
+  int16_t values[7];
+
+  for (int32_t axis = 0; axis < 3; ++axis)
+  {
+    values[axis] = toUnits(motion.accel[axis], accelScale);
+    values[4 + axis] = toUnits(motion.gyro[axis], gyroScale);
+  }
+  // Temperature is 36.53 degrees
+  values[3] = 0;
+
+  uint8_t data[14];
+
+  for (int32_t i = 0; i < 7; ++i)
+  {
+    data[2 * i] = static_cast<uint16_t>(values[i]) >> 8;
+    data[2 * i + 1] = static_cast<uint16_t>(values[i]) & 0xFF;
+  }
+  for (int32_t i = 0; i < 14; ++i)
+    regs[ACCEL_XOUT_H + i] = data[i];
+
+  if ((regs[USER_CTRL] & USER_CTRL_FIFO_EN) != 0)
+  {
+    // FIFO order: accelerometer, temperature, gyroscope axes
+    bool isOn[7] =
+    {
+      (regs[FIFO_EN] & FIFO_EN_ACCEL) != 0, (regs[FIFO_EN] & FIFO_EN_ACCEL) != 0,
+      (regs[FIFO_EN] & FIFO_EN_ACCEL) != 0, (regs[FIFO_EN] & FIFO_EN_TEMP) != 0,
+      (regs[FIFO_EN] & 0x40) != 0, (regs[FIFO_EN] & 0x20) != 0, (regs[FIFO_EN] & 0x10) != 0
+    };
+
+    for (int32_t i = 0; i < 7; ++i)
+      if (isOn[i])
+      {
+        fifo.push_back(data[2 * i]);
+        fifo.push_back(data[2 * i + 1]);
+      }
+    // The oldest data is overwritten
+    if (fifo.size() > FIFO_SIZE)
+    {
+      fifo.erase(fifo.begin(), fifo.begin() + (fifo.size() - FIFO_SIZE));
+      regs[INT_STATUS] |= INT_FIFO_OFLOW;
+    }
+  }
+
+  // Interrupt line of one sensor can be cut
+  static const char *silentSetting = getenv("MITHRIL_SIM_SILENT_INT");
+  static const int32_t silentSensor = silentSetting != nullptr ? atoi(silentSetting) : -1;
+
+  regs[INT_STATUS] |= INT_DATA_RDY;
+  if ((regs[INT_ENABLE] & INT_DATA_RDY) != 0 && static_cast<int32_t>(number) != silentSensor)
+  {
+    uint16_t pin = intPin;
+
+    // Pulse is lost while EXTI interrupt is disabled
+    schedule(0, [pin]()
+    {
+      uint32_t line = __builtin_ctz(pin);
+      IRQn_Type irq = line < 5 ? static_cast<IRQn_Type>(EXTI0_IRQn + line) :
+        line < 10 ? EXTI9_5_IRQn : EXTI15_10_IRQn;
+
+      if ((NVIC->ISER[irq >> 5] >> (irq & 0x1F) & 1) != 0)
+        HAL_GPIO_EXTI_Callback(pin);
+    });
+  }
+} // End of 'mthl::host::Mpu6050Sim::sample' function
+
+/* Time between samples getter */
+mthl::host::Cycles mthl::host::Mpu6050Sim::getSamplePeriod() const
+{
+  // Gyroscope output rate is 8 kHz without low pass filter
+  uint32_t dlpf = regs[CONFIG] & 7;
+
+  return fromMicroseconds(1e6 * (1 + regs[SMPLRT_DIV]) / (dlpf == 0 || dlpf == 7 ? 8000 : 1000));
+} // End of 'mthl::host::Mpu6050Sim::getSamplePeriod' function
@@ -0,0 +1,352 @@
+/******************************
+ * File name   : Replay.cpp
+ * Purpose     : Mithril project.
+ *               Host build module.
+ *               Replay of recorded traces through posture processing
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "ReplayIMU.h"
+#include "Controller/Functionality/Health/Posture/Posture.h"
+#include "Probe.h"
+
+namespace
+{
+  const char USAGE[] =
+    "usage: mithril_replay [--ml] [--filter complementary|madgwick|mahony] [--quiet] TRACE\n"
+    "       mithril_replay --generate TRACE HOURS\n"
+    "Trace is pushed through IMU-sensors filters and posture processing as fast as possible.\n"
+    "Posture verdict changes are printed with trace time, then statistics and throughput.\n"
+    "--generate writes synthetic trace of wearer who sits upright and slouches.\n";
+
+  const uint64_t
+    POSTURE_PERIOD = 100000,   // Posture processing period as in firmware (microseconds)
+    SAMPLE_PERIOD = 100000;    // Sensors sampling period of generated trace (microseconds)
+
+  /* Replay settings structure */
+  struct Settings
+  {
+    const char *path = nullptr;                               // trace file
+    bool isML = false;                                        // use machine learning posture processing
+    bool isQuiet = false;                                     // do not print verdict changes
+    mthl::filters::Type filter = mthl::filters::Type::COMPLEMENTARY; // orientation filter
+  }; // End of 'Settings' structure
+
+  /* Format trace time function.
+   *
+   * Arguments:
+   *   uint64_t time -- time since session start (microseconds)
+   *
+   * Returns:
+   *   Pointer to static string "hh:mm:ss.s".
+   */
+  const char * formatTime(uint64_t time)
+  {
+    static char str[32];
+    uint64_t tenths = time / 100000;
+
+    snprintf(str, sizeof(str), "%02u:%02u:%02u.%u", static_cast<unsigned>(tenths / 36000),
+        static_cast<unsigned>(tenths / 600 % 60), static_cast<unsigned>(tenths / 10 % 60),
+        static_cast<unsigned>(tenths % 10));
+    return str;
+  } // End of 'formatTime' function
+
+  /* Put signed 16-bit register value to burst function.
+   *
+   * Arguments:
+   *   uint8_t *dst -- high byte of register
+   *   float value -- value in register units
+   *
+   * Returns:
+   *   None.
+   */
+  void putRegister(uint8_t *dst, float value)
+  {
+    long raw = std::lround(value);
+    int16_t reg = static_cast<int16_t>(raw < INT16_MIN ? INT16_MIN : raw > INT16_MAX ? INT16_MAX : raw);
+
+    dst[0] = static_cast<uint16_t>(reg) >> 8;
+    dst[1] = static_cast<uint16_t>(reg) & 0xFF;
+  } // End of 'putRegister' function
+
+  /* Generate synthetic trace function.
+   * Three sensors along spine (as connected on board) are tilted forward by
+   * upright or slouched posture which is changed every 1-20 minutes, with
+   * smooth transitions, breathing and sensor noise.
+   *
+   * Arguments:
+   *   const char *path -- trace file
+   *   double hours -- session duration
+   *
+   * Returns:
+   *   Program exit code.
+   */
+  int generate(const char *path, double hours)
+  {
+    const float
+      ACC_SCALE = 16384, GYRO_SCALE = 131, // MPU6050 units at +-2g and +-250 d/s
+      TRANSITION_TIME = 3,                  // time of posture change (seconds)
+      BREATH_AMPLITUDE = 0.5f,              // tilt by breathing (degrees)
+      BREATH_FREQUENCY = 0.25f;             // breathing frequency (Hz)
+    // Spine angles are 180 degrees minus differences of neighbour sensors tilts,
+    // they are in bounds of correct posture for upright tilts and out of them for slouched ones
+    const float
+      UPRIGHT[3] = {24, -15, 54},           // tilt of sensors in upright posture (degrees)
+      SLOUCHED[3] = {8, -4, 16};            // tilt of sensors in slouched posture (degrees)
+    const uint32_t ids[3] =
+    {
+      (I2C1_BASE & 0xFFFF) << 8 | mthl::MCU6050::MPU6050_ADDR_1,
+      (I2C3_BASE & 0xFFFF) << 8 | mthl::MCU6050::MPU6050_ADDR_1,
+      (I2C1_BASE & 0xFFFF) << 8 | mthl::MCU6050::MPU6050_ADDR_2
+    };
+
+    std::mt19937 random(2026);
+    std::normal_distribution<float> accelNoise(0, 0.004f), gyroNoise(0, 0.05f);
+    std::uniform_real_distribution<float> bias(-1, 1), segment(60, 1200);
+    std::vector<mthl::trace::SensorInfo> sensors(3);
+
+    for (uint32_t i = 0; i < sensors.size(); ++i)
+    {
+      sensors[i] = {ids[i], 0, {bias(random), bias(random), bias(random)}, {UPRIGHT[i], 0, UPRIGHT[i]}};
+      sensors[i].angles[2] = std::fabs(UPRIGHT[i]);
+    }
+
+    mthl::trace::Writer writer(path, sensors);
+
+    if (!writer.isValid())
+    {
+      fprintf(stderr, "mithril_replay: can't write %s\n", path);
+      return 1;
+    }
+
+    uint64_t duration = static_cast<uint64_t>(hours * 3600e6);
+    float from = 0, to = 0, prevTilt[3] = {}, segmentStart = 0, segmentEnd = 0;
+    bool isSlouched = true;
+
+    for (uint64_t time = 0; time < duration; time += SAMPLE_PERIOD)
+    {
+      float t = time / 1e6f;
+
+      if (t >= segmentEnd)
+      {
+        isSlouched = !isSlouched;
+        from = to;
+        to = isSlouched ? 1.0f : 0.0f;
+        segmentStart = t;
+        segmentEnd = t + segment(random);
+      }
+
+      float
+        progress = std::fmin((t - segmentStart) / TRANSITION_TIME, 1.0f),
+        slouch = from + (to - from) * (3 - 2 * progress) * progress * progress,
+        breath = BREATH_AMPLITUDE * std::sin(2 * 3.14159265f * BREATH_FREQUENCY * t);
+
+      // Sensors are read one after another
+      for (uint32_t i = 0; i < sensors.size(); ++i)
+      {
+        mthl::trace::Record record = {time + i * 1000, static_cast<uint8_t>(i), 0, {}};
+        float
+          tilt = UPRIGHT[i] + (SLOUCHED[i] - UPRIGHT[i]) * slouch + breath,
+          rate = time == 0 ? 0 : (tilt - prevTilt[i]) / (SAMPLE_PERIOD / 1e6f),
+          rad = tilt * 3.14159265f / 180;
+
+        prevTilt[i] = tilt;
+        putRegister(record.burst + 0, (std::sin(rad) + accelNoise(random)) * ACC_SCALE);
+        putRegister(record.burst + 2, accelNoise(random) * ACC_SCALE);
+        putRegister(record.burst + 4, (std::cos(rad) + accelNoise(random)) * ACC_SCALE);
+        putRegister(record.burst + 6, (30 - 36.53f) * 340);
+        putRegister(record.burst + 8, (rate + sensors[i].gyroBias[0] + gyroNoise(random)) * GYRO_SCALE);
+        putRegister(record.burst + 10, (sensors[i].gyroBias[1] + gyroNoise(random)) * GYRO_SCALE);
+        putRegister(record.burst + 12, (sensors[i].gyroBias[2] + gyroNoise(random)) * GYRO_SCALE);
+        writer.write(record);
+      }
+    }
+    return 0;
+  } // End of 'generate' function
+
+#ifdef MTHL_PROBES
+  /* Print timing probes statistics function.
+   *
+   * Arguments:
+   *   None.
+   *
+   * Returns:
+   *   None.
+   */
+  void printProbes()
+  {
+    printf("Probes (ns): runs, min, max, mean, log2 histogram\n");
+    for (uint32_t i = 0; i < static_cast<uint32_t>(mthl::probe::Id::COUNT); ++i)
+    {
+      auto id = static_cast<mthl::probe::Id>(i);
+      mthl::probe::Stats stats = mthl::probe::getStats(id);
+
+      if (stats.count == 0)
+        continue;
+      printf("  %-14s %10u %6u %8u %8.1f ", mthl::probe::getName(id), stats.count, stats.min, stats.max,
+          static_cast<double>(stats.sum) / stats.count);
+      for (uint32_t bucket = 0; bucket < mthl::probe::HISTOGRAM_SIZE; ++bucket)
+        if (stats.histogram[bucket] != 0)
+          printf(" %u:%u", bucket, stats.histogram[bucket]);
+      printf("\n");
+    }
+  } // End of 'printProbes' function
+#endif // MTHL_PROBES
+
+  /* Replay trace function.
+   *
+   * Arguments:
+   *   const Settings &settings -- replay settings
+   *
+   * Returns:
+   *   Program exit code.
+   */
+  int replay(const Settings &settings)
+  {
+    mthl::trace::Reader reader(settings.path);
+
+    if (!reader.isValid())
+    {
+      fprintf(stderr, "mithril_replay: can't read trace %s\n", settings.path);
+      return 1;
+    }
+    if (reader.getSensors().size() < mthl::SENSORS_COUNT)
+    {
+      fprintf(stderr, "mithril_replay: posture processing needs %u sensors\n",
+          static_cast<unsigned>(mthl::SENSORS_COUNT));
+      return 1;
+    }
+
+    // First sensors of trace are sensors of device, others are only filtered
+    std::vector<std::unique_ptr<mthl::ReplayIMU>> replayed;
+    mthl::SensorSet sensors{};
+
+    for (auto &info : reader.getSensors())
+    {
+      auto sensor = std::make_unique<mthl::ReplayIMU>(info);
+
+      sensor->setFilter(settings.filter);
+      if (replayed.size() < sensors.size())
+        sensors[replayed.size()] = sensor.get();
+      replayed.emplace_back(std::move(sensor));
+    }
+
+#ifdef MTHL_PROBES
+    mthl::probe::reset();
+#endif // MTHL_PROBES
+    mthl::PostureProcASF asf(sensors);
+    mthl::PostureProcML ml(sensors);
+    auto start = std::chrono::steady_clock::now();
+    mthl::trace::Record record;
+    uint64_t
+      samplesCount = 0, verdictsCount = 0, changesCount = 0,
+      nextPosture = POSTURE_PERIOD, lastChange = 0, correctTime = 0, time = 0;
+    bool isCorrect = false;
+
+    // Posture is evaluated by sensors data which came before its time, as in firmware scheduler
+    auto evaluate = [&](uint64_t now)
+    {
+      bool verdict = settings.isML ? ml.evaluate() : asf.evaluate();
+
+      if (verdictsCount++ == 0 || verdict != isCorrect)
+      {
+        if (isCorrect)
+          correctTime += now - lastChange;
+        if (verdictsCount > 1)
+          ++changesCount;
+        lastChange = now;
+        isCorrect = verdict;
+        if (!settings.isQuiet)
+        {
+          if (settings.isML)
+            printf("%s %s\n", formatTime(now), verdict ? "Good" : "Bad");
+          else
+            printf("%s %s  upper %.1f lower %.1f\n", formatTime(now), verdict ? "Good" : "Bad ",
+                static_cast<double>(asf.getSpineAngles()[0]), static_cast<double>(asf.getSpineAngles()[1]));
+        }
+      }
+    };
+
+    while (reader.read(record))
+    {
+      for (; nextPosture <= record.time; nextPosture += POSTURE_PERIOD)
+        evaluate(nextPosture);
+      // Sensors read with DMA are updated right after reading
+      replayed[record.sensor]->push(record);
+      replayed[record.sensor]->update();
+      time = record.time;
+      ++samplesCount;
+    }
+    if (isCorrect)
+      correctTime += time - lastChange;
+
+    double
+      wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(),
+      duration = time / 1e6;
+
+    printf("Trace: %u sensors, %llu samples, %s\n", static_cast<unsigned>(replayed.size()),
+        static_cast<unsigned long long>(samplesCount), formatTime(time));
+    printf("Verdicts: %llu, changes %llu, good %.1f %%\n", static_cast<unsigned long long>(verdictsCount),
+        static_cast<unsigned long long>(changesCount), duration > 0 ? correctTime / 1e4 / duration : 0.0);
+    printf("Replayed %.1f s in %.3f s: %.0f samples/s, %.0fx real time\n", duration, wall,
+        samplesCount / wall, duration / wall);
+#ifdef MTHL_PROBES
+    printProbes();
+#endif // MTHL_PROBES
+    return 0;
+  } // End of 'replay' function
+}
+
+/* Program entry point */
+int main(int argc, char *argv[])
+{
+  Settings settings;
+
+  for (int i = 1; i < argc; ++i)
+    if (strcmp(argv[i], "--generate") == 0 && i + 2 < argc)
+      return generate(argv[i + 1], atof(argv[i + 2]));
+    else if (strcmp(argv[i], "--ml") == 0)
+      settings.isML = true;
+    else if (strcmp(argv[i], "--quiet") == 0)
+      settings.isQuiet = true;
+    else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+    {
+      const char *name = argv[++i];
+
+      if (strcmp(name, "complementary") == 0)
+        settings.filter = mthl::filters::Type::COMPLEMENTARY;
+      else if (strcmp(name, "madgwick") == 0)
+        settings.filter = mthl::filters::Type::MADGWICK;
+      else if (strcmp(name, "mahony") == 0)
+        settings.filter = mthl::filters::Type::MAHONY;
+      else
+      {
+        fputs(USAGE, stderr);
+        return 2;
+      }
+    }
+    else if (argv[i][0] != '-' && settings.path == nullptr)
+      settings.path = argv[i];
+    else
+    {
+      fputs(USAGE, stderr);
+      return 2;
+    }
+
+  if (settings.path == nullptr)
+  {
+    fputs(USAGE, stderr);
+    return 2;
+  }
+  return replay(settings);
+} // End of 'main' function
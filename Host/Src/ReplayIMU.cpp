@@ -0,0 +1,84 @@
+/******************************
+ * File name   : ReplayIMU.cpp
+ * Purpose     : Mithril project.
+ *               Host build module.
+ *               IMU-sensor replaying recorded trace implementation
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include <cstring>
+
+#include "ReplayIMU.h"
+
+/* Replayed IMU-sensor constructor */
+mthl::ReplayIMU::ReplayIMU(const trace::SensorInfo &info) : info(info)
+{
+  calibrate(0);
+} // End of 'mthl::ReplayIMU::ReplayIMU' constructor
+
+/* Pass recorded burst to sensor function */
+void mthl::ReplayIMU::push(const trace::Record &record)
+{
+  memcpy(lastBurst, record.burst, sizeof(lastBurst));
+  lastTime = toCycles(record.time);
+  putMotion(lastBurst, lastTime);
+} // End of 'mthl::ReplayIMU::push' function
+
+/* Read accelerometer data function */
+void mthl::ReplayIMU::readAccel(math::quater<float> &v)
+{
+  Sample sample;
+
+  readMotion(sample);
+  v = sample.accel;
+} // End of 'mthl::ReplayIMU::readAccel' function
+
+/* Read gyroscope data function */
+void mthl::ReplayIMU::readGyro(math::quater<float> &v)
+{
+  Sample sample;
+
+  readMotion(sample);
+  v = sample.gyro;
+} // End of 'mthl::ReplayIMU::readGyro' function
+
+/* Read accelerometer, temperature and gyroscope data function */
+void mthl::ReplayIMU::readMotion(Sample &s)
+{
+  s.time = lastTime;
+  decodeMotion(lastBurst, s);
+} // End of 'mthl::ReplayIMU::readMotion' function
+
+/* Calibrate device function */
+bool mthl::ReplayIMU::calibrate(int32_t iterations)
+{
+  Calibration calibration;
+
+  for (int32_t axis = 0; axis < 3; ++axis)
+  {
+    calibration.gyro[axis] = info.gyroBias[axis];
+    calibration.angles[axis] = info.angles[axis];
+  }
+  setCalibration(calibration);
+  return true;
+} // End of 'mthl::ReplayIMU::calibrate' function
+
+/* Sensor identity getter */
+uint32_t mthl::ReplayIMU::getId()
+{
+  return info.id;
+} // End of 'mthl::ReplayIMU::getId' function
+
+/* Set sampling period function */
+bool mthl::ReplayIMU::setSamplePeriod(uint32_t period)
+{
+  return false;
+} // End of 'mthl::ReplayIMU::setSamplePeriod' function
+
+/* Convert trace time to timer cycles function */
+uint32_t mthl::ReplayIMU::toCycles(uint64_t time)
+{
+  return static_cast<uint32_t>(time * SystemCoreClock / 1000000);
+} // End of 'mthl::ReplayIMU::toCycles' function
@@ -0,0 +1,113 @@
+/******************************
+ * File name   : Trace.cpp
+ * Purpose     : Mithril project.
+ *               Host build module.
+ *               Recorded IMU-sensors trace reading and writing
+ * Author      : Tarasov Denis
+ * Create date : 18.10.2026
+ * Last change : 18.10.2026
+ ******************************/
+
+#include <cstring>
+
+#include "Trace.h"
+
+namespace
+{
+  const char MAGIC[4] = {'M', 'T', 'R', 'C'}; // Trace file signature
+}
+
+/* Reader constructor */
+mthl::trace::Reader::Reader(const char *path) : file(fopen(path, "rb"))
+{
+  Header header;
+
+  if (file == nullptr)
+    return;
+  if (fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header.version != VERSION)
+  {
+    fclose(file);
+    file = nullptr;
+    return;
+  }
+
+  sensors.resize(header.sensorsCount);
+  if (fread(sensors.data(), sizeof(SensorInfo), sensors.size(), file) != sensors.size())
+  {
+    fclose(file);
+    file = nullptr;
+  }
+} // End of 'mthl::trace::Reader::Reader' constructor
+
+/* Reader destructor */
+mthl::trace::Reader::~Reader()
+{
+  if (file != nullptr)
+    fclose(file);
+} // End of 'mthl::trace::Reader::~Reader' destructor
+
+/* Trace validity getter */
+bool mthl::trace::Reader::isValid() const
+{
+  return file != nullptr;
+} // End of 'mthl::trace::Reader::isValid' function
+
+/* Sensors descriptions getter */
+const std::vector<mthl::trace::SensorInfo> & mthl::trace::Reader::getSensors() const
+{
+  return sensors;
+} // End of 'mthl::trace::Reader::getSensors' function
+
+/* Read next record function */
+bool mthl::trace::Reader::read(Record &record)
+{
+  if (position == buffer.size())
+  {
+    if (file == nullptr)
+      return false;
+    buffer.resize(BUFFER_RECORDS);
+    buffer.resize(fread(buffer.data(), sizeof(Record), BUFFER_RECORDS, file));
+    position = 0;
+    if (buffer.empty())
+      return false;
+  }
+
+  record = buffer[position++];
+  // Records of unknown sensors are not passed
+  return record.sensor < sensors.size() || read(record);
+} // End of 'mthl::trace::Reader::read' function
+
+/* Writer constructor */
+mthl::trace::Writer::Writer(const char *path, const std::vector<SensorInfo> &sensors)
+  : file(fopen(path, "wb"))
+{
+  Header header;
+
+  if (file == nullptr)
+    return;
+  memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.sensorsCount = static_cast<uint16_t>(sensors.size());
+  fwrite(&header, sizeof(header), 1, file);
+  fwrite(sensors.data(), sizeof(SensorInfo), sensors.size(), file);
+} // End of 'mthl::trace::Writer::Writer' constructor
+
+/* Writer destructor */
+mthl::trace::Writer::~Writer()
+{
+  if (file != nullptr)
+    fclose(file);
+} // End of 'mthl::trace::Writer::~Writer' destructor
+
+/* Writer validity getter */
+bool mthl::trace::Writer::isValid() const
+{
+  return file != nullptr;
+} // End of 'mthl::trace::Writer::isValid' function
+
+/* Write record function */
+void mthl::trace::Writer::write(const Record &record)
+{
+  fwrite(&record, sizeof(record), 1, file);
+} // End of 'mthl::trace::Writer::write' function
@@ -0,0 +1,46 @@
+# Mithril project.
+# Telemetry angles check: firmware runs with IMU-sensors tilted by TILT degrees,
+# application link output is decoded and every filtered angles message must
+# have first (X axis) angle within 0.5 degree of tilt. With TILT_TIME sensors
+# are turned at this time (seconds), so filters must follow the turn before
+# telemetry starts.
+#
+#   cmake -DHOST=mithril_host -DPYTHON=python3 -DDECODER=telemetry_decode.py
+#         -DINPUT=telemetry.txt -DOUTPUT=link.bin -DTILT=20 [-DTILT_TIME=3]
+#         -P TelemetryAngles.cmake
+
+set(ENV{MITHRIL_SIM_TIME} 8)
+set(ENV{MITHRIL_SIM_TILT} ${TILT})
+if(DEFINED TILT_TIME)
+  set(ENV{MITHRIL_SIM_TILT_TIME} ${TILT_TIME})
+endif()
+set(ENV{MITHRIL_SIM_INPUT} ${INPUT})
+set(ENV{MITHRIL_SIM_UART6} ${OUTPUT})
+
+execute_process(COMMAND ${HOST} OUTPUT_QUIET RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "mithril_host failed: ${result}")
+endif()
+
+execute_process(COMMAND ${PYTHON} ${DECODER} ${OUTPUT} OUTPUT_VARIABLE decoded RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "telemetry decoder failed: ${result}")
+endif()
+
+string(REGEX MATCHALL "'type': 'angles'[^\n]*" angles "${decoded}")
+list(LENGTH angles count)
+if(count EQUAL 0)
+  message(FATAL_ERROR "no angles messages in telemetry")
+endif()
+
+foreach(message IN LISTS angles)
+  string(REGEX MATCH "'angles': \\[(-?[0-9.]+)," match "${message}")
+  # Angles are compared as fixed point numbers with 2 fraction digits
+  string(REGEX REPLACE "^(-?[0-9]+)\\.([0-9])$" "\\1.\\20" angle "${CMAKE_MATCH_1}")
+  string(REPLACE "." "" angle "${angle}")
+  math(EXPR delta "${angle} - ${TILT} * 100")
+  if(delta GREATER 50 OR delta LESS -50)
+    message(FATAL_ERROR "angle ${CMAKE_MATCH_1} differs from tilt ${TILT}: ${message}")
+  endif()
+endforeach()
+message("Telemetry: ${count} angles messages match tilt ${TILT}")
@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+"""Mithril project.
+
+Command frames encoder. Frame is zero byte, COBS-encoded packet, zero byte;
+packet is version (u8), command (u8), little-endian arguments, CRC16 (CCITT-FALSE)
+(see Core/Inc/Controller/Request/CommandParser.h).
+
+Usage:
+    mithril_command.py posture-bounds ANGLE MIN MAX   bounds of spine angle (degrees)
+    mithril_command.py filter-time-const SECONDS      complementary filter time constant
+    mithril_command.py sample-period MILLISECONDS     IMU-sensors sampling period
+    mithril_command.py telemetry raw angles spine posture   subscribed messages
+Frame is written to stdout or sent to --serial port.
+"""
+
+import argparse
+import struct
+import sys
+
+from telemetry_decode import VERSION, SPINE_ANGLE_SCALE, crc16, cobs_encode
+
+SET_POSTURE_BOUNDS, SET_FILTER_TIME_CONST, SET_SAMPLE_PERIOD, SET_TELEMETRY = 0x80, 0x81, 0x82, 0x83
+TELEMETRY_BITS = {'raw': 1, 'angles': 2, 'spine': 4, 'posture': 8}
+
+
+def encode_command(command, payload=b''):
+    packet = bytes([VERSION, command]) + payload
+    return b'\0' + cobs_encode(packet + struct.pack('<H', crc16(packet))) + b'\0'
+
+
+def build(args):
+    if args.command == 'posture-bounds':
+        angle, low, high = int(args.values[0]), float(args.values[1]), float(args.values[2])
+        return encode_command(SET_POSTURE_BOUNDS, struct.pack('<Bhh', angle, round(low * SPINE_ANGLE_SCALE),
+                                                              round(high * SPINE_ANGLE_SCALE)))
+    if args.command == 'filter-time-const':
+        return encode_command(SET_FILTER_TIME_CONST, struct.pack('<H', round(float(args.values[0]) * 1000)))
+    if args.command == 'sample-period':
+        return encode_command(SET_SAMPLE_PERIOD, struct.pack('<H', int(args.values[0])))
+    mask = 0
+    for name in args.values:
+        mask |= TELEMETRY_BITS[name]
+    return encode_command(SET_TELEMETRY, bytes([mask]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Mithril command frames encoder')
+    parser.add_argument('command', choices=['posture-bounds', 'filter-time-const', 'sample-period', 'telemetry'])
+    parser.add_argument('values', nargs='*')
+    parser.add_argument('--serial', help='serial port of application link')
+    parser.add_argument('--baud', type=int, default=9600)
+    args = parser.parse_args()
+
+    frame = build(args)
+    if args.serial:
+        import serial
+        with serial.Serial(args.serial, args.baud) as port:
+            port.write(frame)
+    else:
+        sys.stdout.buffer.write(frame)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,224 @@
+#!/usr/bin/env python3
+"""Mithril project.
+
+Binary telemetry decoder. Protocol is described in Core/Inc/Telemetry/Telemetry.h:
+COBS-encoded packets delimited by zero bytes, each packet is
+version (u8), type (u8), sequence (u8), time (u32), payload, CRC16 (CCITT-FALSE).
+
+Usage:
+    telemetry_decode.py FILE          decode captured bytes ('-' for stdin)
+    telemetry_decode.py --serial PORT decode live link (needs pyserial)
+    telemetry_decode.py --selftest    encode and decode sample frames
+"""
+
+import argparse
+import struct
+import sys
+
+VERSION = 1
+HEADER = struct.Struct('<BBBI')
+
+ACCEL_SCALE = 1000.0
+GYRO_SCALE = 100.0
+ANGLE_SCALE = 100.0
+SPINE_ANGLE_SCALE = 100.0
+
+RAW_IMU, ANGLES, SPINE_ANGLES, POSTURE, LOG_ENTRIES = 1, 2, 3, 4, 5
+
+# Posture log events (Core/Inc/Storage/PostureLog.h)
+LOG_BOOT, LOG_POSTURE, LOG_ANGLES = 1, 2, 3
+
+
+def crc16(data):
+    """CRC16 CCITT-FALSE: polynomial 0x1021, initial value 0xFFFF."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_encode(data):
+    out, block = bytearray(), bytearray()
+    for byte in data:
+        if byte == 0:
+            out += bytes([len(block) + 1]) + block
+            block = bytearray()
+        else:
+            block.append(byte)
+            if len(block) == 254:
+                out += bytes([255]) + block
+                block = bytearray()
+    out += bytes([len(block) + 1]) + block
+    return bytes(out)
+
+
+def cobs_decode(data):
+    out, i = bytearray(), 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(data):
+            raise ValueError('broken COBS block')
+        out += data[i:i + code - 1]
+        i += code - 1
+        if code != 255 and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def encode_frame(msg_type, sequence, time, payload):
+    packet = HEADER.pack(VERSION, msg_type, sequence, time) + payload
+    return cobs_encode(packet + struct.pack('<H', crc16(packet))) + b'\0'
+
+
+def decode_payload(msg_type, payload):
+    if msg_type == RAW_IMU:
+        sensor, *v = struct.unpack('<B6h', payload)
+        return {'sensor': sensor,
+                'accel': [x / ACCEL_SCALE for x in v[:3]],
+                'gyro': [x / GYRO_SCALE for x in v[3:]]}
+    if msg_type == ANGLES:
+        sensor, *v = struct.unpack('<B3h', payload)
+        return {'sensor': sensor, 'angles': [x / ANGLE_SCALE for x in v]}
+    if msg_type == SPINE_ANGLES:
+        count = payload[0]
+        v = struct.unpack('<%dh' % count, payload[1:1 + 2 * count])
+        return {'angles': [x / SPINE_ANGLE_SCALE for x in v]}
+    if msg_type == POSTURE:
+        return {'correct': bool(payload[0])}
+    if msg_type == LOG_ENTRIES:
+        count = payload[0]
+        v = struct.unpack('<%dI' % (2 * count), payload[1:1 + 8 * count])
+        return {'entries': [decode_log_entry(v[i], v[i + 1]) for i in range(0, len(v), 2)]}
+    return {'raw': payload.hex()}
+
+
+def decode_log_entry(header, data):
+    entry = {'uptime': header & 0xFFFFFF}
+    event = header >> 24
+    if event == LOG_BOOT:
+        entry.update(event='boot', boot=data)
+    elif event == LOG_POSTURE:
+        entry.update(event='posture', correct=bool(data))
+    elif event == LOG_ANGLES:
+        upper, lower = struct.unpack('<2h', struct.pack('<I', data))
+        entry.update(event='angles', angles=[upper / SPINE_ANGLE_SCALE, lower / SPINE_ANGLE_SCALE])
+    else:
+        entry.update(event=event, data=data)
+    return entry
+
+
+NAMES = {RAW_IMU: 'raw_imu', ANGLES: 'angles', SPINE_ANGLES: 'spine_angles', POSTURE: 'posture',
+         LOG_ENTRIES: 'log_entries'}
+
+
+def decode_frame(frame):
+    """Decode frame without zero delimiter. Returns message dictionary."""
+    packet = cobs_decode(frame)
+    if len(packet) < HEADER.size + 2:
+        raise ValueError('short packet')
+    body, crc = packet[:-2], struct.unpack('<H', packet[-2:])[0]
+    if crc16(body) != crc:
+        raise ValueError('bad CRC')
+    version, msg_type, sequence, time = HEADER.unpack(body[:HEADER.size])
+    if version != VERSION:
+        raise ValueError('unknown version %d' % version)
+    message = {'type': NAMES.get(msg_type, msg_type), 'seq': sequence, 'time': time}
+    message.update(decode_payload(msg_type, body[HEADER.size:]))
+    return message
+
+
+class Decoder:
+    """Stream decoder: splits bytes by zero delimiters and decodes frames."""
+
+    def __init__(self, verbose=True):
+        self.verbose = verbose
+        self.buffer = bytearray()
+        self.errors = 0
+        self.lost = 0
+        self.prev_seq = None
+
+    def feed(self, data):
+        self.buffer += data
+        while True:
+            end = self.buffer.find(0)
+            if end < 0:
+                return
+            frame, self.buffer = bytes(self.buffer[:end]), self.buffer[end + 1:]
+            if not frame:
+                continue
+            try:
+                message = decode_frame(frame)
+            except (ValueError, struct.error) as e:
+                self.errors += 1
+                if self.verbose:
+                    print('error: %s' % e, file=sys.stderr)
+                continue
+            if self.prev_seq is not None:
+                self.lost += (message['seq'] - self.prev_seq - 1) & 0xFF
+            self.prev_seq = message['seq']
+            yield message
+
+
+def selftest():
+    frames = [
+        encode_frame(RAW_IMU, 0, 1000, struct.pack('<B6h', 0, 12, -980, 1000, 150, -20, 0)),
+        encode_frame(ANGLES, 1, 1000, struct.pack('<B3h', 1, 2000, 0, -9000)),
+        encode_frame(SPINE_ANGLES, 2, 1100, struct.pack('<B2h', 2, 14550, 13700)),
+        encode_frame(POSTURE, 3, 1100, b'\x01'),
+        encode_frame(RAW_IMU, 4, 0, bytes(13)),
+        encode_frame(LOG_ENTRIES, 5, 1200, struct.pack('<B4I', 2, 7 | LOG_BOOT << 24, 3,
+                                                       60 | LOG_ANGLES << 24, 14550 | 13700 << 16)),
+    ]
+    corrupted = bytearray(frames[1])
+    corrupted[3] ^= 0x40
+    decoder = Decoder(verbose=False)
+    messages = list(decoder.feed(b''.join(frames[:1]) + bytes(corrupted) + b''.join(frames[1:])))
+    assert len(messages) == 6 and decoder.errors == 1, (messages, decoder.errors)
+    assert messages[0]['accel'] == [0.012, -0.98, 1.0]
+    assert messages[1]['angles'] == [20.0, 0.0, -90.0]
+    assert messages[2]['angles'] == [145.5, 137.0]
+    assert messages[3]['correct'] is True
+    assert messages[4]['gyro'] == [0.0, 0.0, 0.0]
+    assert messages[5]['entries'] == [{'uptime': 7, 'event': 'boot', 'boot': 3},
+                                      {'uptime': 60, 'event': 'angles', 'angles': [145.5, 137.0]}]
+    long_data = bytes(range(1, 256)) * 3 + b'\0'
+    assert cobs_decode(cobs_encode(long_data)) == long_data
+    assert crc16(b'123456789') == 0x29B1
+    print('selftest passed')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Mithril telemetry decoder')
+    parser.add_argument('file', nargs='?', help="captured bytes, '-' for stdin")
+    parser.add_argument('--serial', help='serial port of application link')
+    parser.add_argument('--baud', type=int, default=9600)
+    parser.add_argument('--selftest', action='store_true')
+    args = parser.parse_args()
+
+    if args.selftest:
+        selftest()
+        return
+
+    decoder = Decoder()
+    if args.serial:
+        import serial
+        with serial.Serial(args.serial, args.baud, timeout=1) as port:
+            while True:
+                for message in decoder.feed(port.read(256)):
+                    print(message, flush=True)
+    elif args.file:
+        stream = sys.stdin.buffer if args.file == '-' else open(args.file, 'rb')
+        with stream:
+            for message in decoder.feed(stream.read()):
+                print(message)
+        print('errors: %d, lost frames: %d' % (decoder.errors, decoder.lost), file=sys.stderr)
+    else:
+        parser.print_help()
+
+
+if __name__ == '__main__':
+    main()